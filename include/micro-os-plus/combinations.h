@@ -0,0 +1,204 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+#ifndef MICRO_TEST_PLUS_COMBINATIONS_H_
+#define MICRO_TEST_PLUS_COMBINATIONS_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wc++98-c++11-c++14-c++17-compat-pedantic"
+#endif
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  /**
+   * @brief Options to configure the combinations() of parameters.
+   * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+   */
+  struct combinations_options
+  {
+    /**
+     * @brief The number of parameters whose values are covered
+     * in all combinations; 2 for all pairs, 3 for all triples.
+     */
+    std::size_t strength = 2;
+
+    /**
+     * @brief The maximum number of test cases, 0 for no limit;
+     * with a limit, the coverage may be partial.
+     */
+    std::size_t max_cases = 0;
+  };
+
+  namespace detail
+  {
+    /**
+     * @brief A reporter used only to format the names of the test
+     * cases, with the same rules as the values of the failed checks.
+     */
+    class name_formatter : public test_reporter
+    {
+    public:
+      [[nodiscard]] const char*
+      c_str (void) const
+      {
+        return out_.c_str ();
+      }
+    };
+
+    template <class Tuple_T, std::size_t First, std::size_t... Is>
+    void
+    run_combinations (const char* name, const combinations_options& options,
+                      Tuple_T& arguments, std::index_sequence<Is...>)
+    {
+      constexpr std::size_t count = sizeof...(Is);
+      auto& body = std::get<std::tuple_size_v<Tuple_T> - 1> (arguments);
+
+      const std::size_t sizes[count]
+          = { static_cast<std::size_t> (
+              std::size (std::get<First + Is> (arguments)))... };
+      std::vector<std::size_t> rows;
+      const auto coverage = covering_array (sizes, count, options.strength,
+                                            options.max_cases, rows);
+
+      reporter.output_coverage (name, coverage);
+
+      for (std::size_t r = 0; r < coverage.cases; ++r)
+        {
+          const std::size_t* row = &rows[r * count];
+
+          // The name must be valid until the end of the test case.
+          name_formatter case_name;
+          case_name << name << " (";
+          std::size_t i = 0;
+          ((case_name << (i++ == 0 ? "" : ", "),
+            print_value (case_name, std::begin (std::get<First + Is> (
+                                        arguments))[row[Is]])),
+           ...);
+          case_name << ")";
+
+          test_case (case_name.c_str (), [&] {
+            body (std::begin (std::get<First + Is> (arguments))[row[Is]]...);
+          });
+        }
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+
+  /**
+   * @ingroup micro-test-plus-test-case
+   * @brief Execute a test case for each combination of parameter
+   * values of a covering array.
+   * @tparam Args_T The types of the arguments.
+   * @param [in] name The name of the group of test cases.
+   * @param [in] arguments An optional `combinations_options`, followed
+   * by the values of each parameter (arrays or containers with random
+   * access), followed by the body, called with one value of each
+   * parameter.
+   * @par Returns
+   *  Nothing.
+   *
+   * @details
+   * Instead of the full product of all parameter values, a much
+   * smaller set of combinations is generated, such that each pair
+   * of values of any two parameters (or each tuple of
+   * `options.strength` parameters) is present in at least one
+   * test case.
+   *
+   * The number of test cases and the coverage are reported before
+   * the test cases; each test case is named with the values
+   * appended in parenthesis.
+   *
+   * @par Example
+   *
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   *
+   * static constexpr int bauds[] = { 9600, 19200, 57600, 115200 };
+   * static constexpr char parities[] = { 'N', 'E', 'O' };
+   * static constexpr int stop_bits[] = { 1, 2 };
+   * static constexpr bool flow_control[] = { false, true };
+   *
+   * mt::combinations ("Serial", bauds, parities, stop_bits, flow_control,
+   *                   [] (int baud, char parity, int stop, bool flow) {
+   *                     mt::expect (uart_configure (baud, parity, stop,
+   *                                                 flow));
+   *                   });
+   * ```
+   */
+  template <class... Args_T>
+  void
+  combinations (const char* name, Args_T&&... arguments)
+  {
+    static_assert (sizeof...(Args_T) >= 2,
+                   "at least one parameter and the body are mandatory");
+    auto tuple = std::forward_as_tuple (std::forward<Args_T> (arguments)...);
+    using tuple_t = decltype (tuple);
+    constexpr std::size_t size = sizeof...(Args_T);
+
+    if constexpr (std::is_same_v<std::remove_cv_t<std::remove_reference_t<
+                                     std::tuple_element_t<0, tuple_t>>>,
+                                 combinations_options>)
+      {
+        static_assert (size >= 3,
+                       "at least one parameter and the body are mandatory");
+        detail::run_combinations<tuple_t, 1> (
+            name, std::get<0> (tuple), tuple,
+            std::make_index_sequence<size - 2>{});
+      }
+    else
+      {
+        detail::run_combinations<tuple_t, 0> (
+            name, combinations_options{}, tuple,
+            std::make_index_sequence<size - 1>{});
+      }
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_TEST_PLUS_COMBINATIONS_H_
+
+// ----------------------------------------------------------------------------
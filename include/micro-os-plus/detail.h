@@ -24,6 +24,16 @@
 // ----------------------------------------------------------------------------
 
 #include <stdio.h>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+#include <thread>
+#endif
 
 // ----------------------------------------------------------------------------
 
@@ -40,6 +50,13 @@ namespace micro_os_plus::micro_test_plus
 {
   // --------------------------------------------------------------------------
 
+  class test_reporter;
+
+  namespace mock
+  {
+    class method_base;
+  } // namespace mock
+
   /**
    * @brief Namespace with implementation details, not part of the public API.
    */
@@ -58,6 +75,28 @@ namespace micro_os_plus::micro_test_plus
 
     // ------------------------------------------------------------------------
 
+    /**
+     * @brief Convert an integer to another integer type, with a cast
+     * only when the types differ, since the fixed width types are
+     * aliases of different types on different platforms, like
+     * `std::uint64_t` of `std::size_t` on 64-bit platforms only.
+     */
+    template <class To_T, class From_T>
+    [[nodiscard]] constexpr To_T
+    integer_cast (From_T value)
+    {
+      if constexpr (std::is_same_v<To_T, From_T>)
+        {
+          return value;
+        }
+      else
+        {
+          return static_cast<To_T> (value);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+
     /**
      * @brief Generic getter implementation. If the type has
      * a get() method, call it. It is recommended for custom types
@@ -92,6 +131,38 @@ namespace micro_os_plus::micro_test_plus
       return get_impl (t, 0);
     }
 
+    /**
+     * @brief Epsilon getter implementation for values that
+     * store their own precision.
+     */
+    template <class T>
+    [[nodiscard]] constexpr auto
+    get_epsilon_impl (const T& t, int) -> decltype (t.epsilon_)
+    {
+      return t.epsilon_;
+    }
+
+    /**
+     * @brief Epsilon getter implementation for constants, which
+     * have the precision as a static member.
+     */
+    template <class T>
+    [[nodiscard]] constexpr auto
+    get_epsilon_impl (const T&, ...) -> decltype (T::epsilon)
+    {
+      return T::epsilon;
+    }
+
+    /**
+     * @brief Generic epsilon getter, calling the implementation.
+     */
+    template <class T>
+    [[nodiscard]] constexpr auto
+    get_epsilon (const T& t)
+    {
+      return get_epsilon_impl (t, 0);
+    }
+
     // ------------------------------------------------------------------------
 
     /**
@@ -132,17 +203,20 @@ namespace micro_os_plus::micro_test_plus
                   // If both values have precision, compare them using
                   // the smalles precision.
                   return math::abs (get (lhs) - get (rhs))
-                         < math::min_value (Lhs_T::epsilon, Rhs_T::epsilon);
+                         < math::min_value (get_epsilon (lhs),
+                                               get_epsilon (rhs));
                 }
               else if constexpr (type_traits::has_epsilon_v<Lhs_T>)
                 {
                   // If only the left operand has precision, use it.
-                  return math::abs (get (lhs) - get (rhs)) < Lhs_T::epsilon;
+                  return math::abs (get (lhs) - get (rhs))
+                         < get_epsilon (lhs);
                 }
               else if constexpr (type_traits::has_epsilon_v<Rhs_T>)
                 {
                   // If only the right operand has precision, use it.
-                  return math::abs (get (lhs) - get (rhs)) < Rhs_T::epsilon;
+                  return math::abs (get (lhs) - get (rhs))
+                         < get_epsilon (rhs);
                 }
               else
                 {
@@ -213,15 +287,18 @@ namespace micro_os_plus::micro_test_plus
                                  and type_traits::has_epsilon_v<Rhs_T>)
                 {
                   return math::abs (get (lhs_) - get (rhs_))
-                         > math::min_value (Lhs_T::epsilon, Rhs_T::epsilon);
+                         > math::min_value (get_epsilon (lhs_),
+                                               get_epsilon (rhs_));
                 }
               else if constexpr (type_traits::has_epsilon_v<Lhs_T>)
                 {
-                  return math::abs (get (lhs_) - get (rhs_)) > Lhs_T::epsilon;
+                  return math::abs (get (lhs_) - get (rhs_))
+                         > get_epsilon (lhs_);
                 }
               else if constexpr (type_traits::has_epsilon_v<Rhs_T>)
                 {
-                  return math::abs (get (lhs_) - get (rhs_)) > Rhs_T::epsilon;
+                  return math::abs (get (lhs_) - get (rhs_))
+                         > get_epsilon (rhs_);
                 }
               else
                 {
@@ -424,7 +501,6 @@ namespace micro_os_plus::micro_test_plus
         return get (rhs_);
       }
 
-    private:
       const Lhs_T lhs_{};
       const Rhs_T rhs_{};
       const bool value_{};
@@ -691,6 +767,695 @@ namespace micro_os_plus::micro_test_plus
 
     // ------------------------------------------------------------------------
 
+    /**
+     * @brief Find the first byte that differs in two memory areas.
+     * @param [in] lhs Pointer to the first memory area.
+     * @param [in] rhs Pointer to the second memory area.
+     * @param [in] size The number of bytes to compare.
+     * @return The offset of the first different byte, or `size` if
+     * the areas are equal.
+     */
+    [[nodiscard]] std::size_t
+    mismatch_offset (const void* lhs, const void* rhs, std::size_t size);
+
+    /**
+     * @brief Find the first byte that differs from a pattern.
+     * @param [in] data Pointer to the memory area.
+     * @param [in] pattern The expected value of all bytes.
+     * @param [in] size The number of bytes to check.
+     * @return The offset of the first different byte, or `size` if
+     * all bytes are equal to the pattern.
+     */
+    [[nodiscard]] std::size_t
+    fill_mismatch_offset (const void* data, std::uint8_t pattern,
+                          std::size_t size);
+
+    /**
+     * @brief The results of comparing two arrays of floating point values.
+     */
+    struct close_result
+    {
+      /**
+       * @brief The number of elements that are not close.
+       */
+      std::size_t violations = 0;
+
+      /**
+       * @brief The index of the element with the largest difference.
+       */
+      std::size_t worst_index = 0;
+
+      /**
+       * @brief The largest absolute difference (infinity for NaNs).
+       */
+      double worst_error = 0;
+
+      double worst_lhs = 0;
+      double worst_rhs = 0;
+    };
+
+    /**
+     * @brief Compare two arrays of floating point values with tolerances.
+     * @param [in] lhs Pointer to the first array.
+     * @param [in] rhs Pointer to the second array.
+     * @param [in] size The number of elements to compare.
+     * @param [in] rel_tol The relative tolerance.
+     * @param [in] abs_tol The absolute tolerance.
+     * @param [in] max_ulps The maximum distance in units in the last place.
+     * @return The number of violations and the worst element.
+     */
+    [[nodiscard]] close_result
+    all_close_values (const float* lhs, const float* rhs, std::size_t size,
+                      double rel_tol, double abs_tol, std::uint64_t max_ulps);
+
+    [[nodiscard]] close_result
+    all_close_values (const double* lhs, const double* rhs, std::size_t size,
+                      double rel_tol, double abs_tol, std::uint64_t max_ulps);
+
+    /**
+     * @brief Find the first element that differs in two arrays.
+     * @return The index of the first different element, or `size` if
+     * the arrays are equal.
+     *
+     * @details
+     * Arrays of scalars whose value is fully defined by their bits
+     * (integers, enums, pointers, but not floats) are compared
+     * as raw memory, with the vectorised `mismatch_offset()`;
+     * all other types use their `operator==`.
+     */
+    template <class Lhs_T, class Rhs_T>
+    [[nodiscard]] constexpr std::size_t
+    first_mismatch (const Lhs_T* lhs, const Rhs_T* rhs, std::size_t size)
+    {
+      if constexpr (std::is_same_v<Lhs_T, Rhs_T> and std::is_scalar_v<Lhs_T>
+                    and std::has_unique_object_representations_v<Lhs_T>)
+        {
+          if (not std::is_constant_evaluated ())
+            {
+              return mismatch_offset (lhs, rhs, size * sizeof (Lhs_T))
+                     / sizeof (Lhs_T);
+            }
+        }
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+#endif
+      for (std::size_t i = 0; i < size; ++i)
+        {
+          if (not(lhs[i] == rhs[i]))
+            {
+              return i;
+            }
+        }
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+      return size;
+    }
+
+    /**
+     * @brief Equality comparator for contiguous ranges of elements.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     *
+     * @details
+     * Only pointers to the elements are kept, so the object must not
+     * outlive the compared containers.
+     */
+    template <class Lhs_T, class Rhs_T>
+    struct eq_range_ : type_traits::op
+    {
+      /**
+       * @brief The number of elements displayed on each side
+       * of the first difference.
+       */
+      static constexpr std::size_t window = 3;
+
+      constexpr eq_range_ (const Lhs_T* lhs, std::size_t lhs_size,
+                           const Rhs_T* rhs, std::size_t rhs_size)
+          : lhs_{ lhs }, rhs_{ rhs }, lhs_size_{ lhs_size },
+            rhs_size_{ rhs_size },
+            mismatch_{ first_mismatch (
+                lhs, rhs, lhs_size < rhs_size ? lhs_size : rhs_size) },
+            value_{ lhs_size == rhs_size and mismatch_ == lhs_size }
+      {
+      }
+
+      [[nodiscard]] constexpr
+      operator bool () const
+      {
+        return value_;
+      }
+
+      [[nodiscard]] constexpr auto
+      lhs () const
+      {
+        return lhs_;
+      }
+
+      [[nodiscard]] constexpr auto
+      rhs () const
+      {
+        return rhs_;
+      }
+
+      [[nodiscard]] constexpr std::size_t
+      lhs_size () const
+      {
+        return lhs_size_;
+      }
+
+      [[nodiscard]] constexpr std::size_t
+      rhs_size () const
+      {
+        return rhs_size_;
+      }
+
+      /**
+       * @brief The index of the first different element; if one
+       * range is the prefix of the other, it is the shorter size.
+       */
+      [[nodiscard]] constexpr std::size_t
+      mismatch () const
+      {
+        return mismatch_;
+      }
+
+      const Lhs_T* const lhs_{};
+      const Rhs_T* const rhs_{};
+      const std::size_t lhs_size_{};
+      const std::size_t rhs_size_{};
+      const std::size_t mismatch_{};
+      const bool value_{};
+    };
+
+    /**
+     * @brief Equality comparator for raw memory areas.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     */
+    struct eq_bytes_ : type_traits::op
+    {
+      /**
+       * @brief The maximum number of different rows displayed
+       * in the hex dump.
+       */
+      static constexpr std::size_t max_rows = 8;
+
+      eq_bytes_ (const void* lhs, const void* rhs, std::size_t size)
+          : lhs_{ static_cast<const std::uint8_t*> (lhs) },
+            rhs_{ static_cast<const std::uint8_t*> (rhs) }, size_{ size },
+            mismatch_{ mismatch_offset (lhs, rhs, size) },
+            value_{ mismatch_ == size }
+      {
+      }
+
+      [[nodiscard]] operator bool () const
+      {
+        return value_;
+      }
+
+      [[nodiscard]] auto
+      lhs () const
+      {
+        return lhs_;
+      }
+
+      [[nodiscard]] auto
+      rhs () const
+      {
+        return rhs_;
+      }
+
+      [[nodiscard]] std::size_t
+      size () const
+      {
+        return size_;
+      }
+
+      [[nodiscard]] std::size_t
+      mismatch () const
+      {
+        return mismatch_;
+      }
+
+      const std::uint8_t* const lhs_{};
+      const std::uint8_t* const rhs_{};
+      const std::size_t size_{};
+      const std::size_t mismatch_{};
+      const bool value_{};
+    };
+
+    /**
+     * @brief Comparator for memory areas filled with a byte pattern.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     */
+    struct filled_with_ : type_traits::op
+    {
+      static constexpr std::size_t max_rows = eq_bytes_::max_rows;
+
+      filled_with_ (const void* data, std::size_t size, std::uint8_t pattern)
+          : data_{ static_cast<const std::uint8_t*> (data) }, size_{ size },
+            pattern_{ pattern },
+            mismatch_{ fill_mismatch_offset (data, pattern, size) },
+            value_{ mismatch_ == size }
+      {
+      }
+
+      [[nodiscard]] operator bool () const
+      {
+        return value_;
+      }
+
+      [[nodiscard]] auto
+      data () const
+      {
+        return data_;
+      }
+
+      [[nodiscard]] std::size_t
+      size () const
+      {
+        return size_;
+      }
+
+      [[nodiscard]] std::uint8_t
+      pattern () const
+      {
+        return pattern_;
+      }
+
+      [[nodiscard]] std::size_t
+      mismatch () const
+      {
+        return mismatch_;
+      }
+
+      const std::uint8_t* const data_{};
+      const std::size_t size_{};
+      const std::uint8_t pattern_{};
+      const std::size_t mismatch_{};
+      const bool value_{};
+    };
+
+    /**
+     * @brief Comparator for arrays of floating point values,
+     * with tolerances.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     */
+    struct all_close_ : type_traits::op
+    {
+      template <class T>
+      all_close_ (const T* lhs, std::size_t lhs_size, const T* rhs,
+                  std::size_t rhs_size, double rel_tol, double abs_tol,
+                  std::uint64_t max_ulps)
+          : type_name_{ sizeof (T) == sizeof (float) ? "float" : "double" },
+            lhs_size_{ lhs_size }, rhs_size_{ rhs_size }, rel_tol_{ rel_tol },
+            abs_tol_{ abs_tol }, max_ulps_{ max_ulps },
+            result_{ all_close_values (
+                lhs, rhs, lhs_size < rhs_size ? lhs_size : rhs_size, rel_tol,
+                abs_tol, max_ulps) },
+            value_{ lhs_size == rhs_size and result_.violations == 0 }
+      {
+      }
+
+      [[nodiscard]] operator bool () const
+      {
+        return value_;
+      }
+
+      [[nodiscard]] const char*
+      type_name () const
+      {
+        return type_name_;
+      }
+
+      [[nodiscard]] std::size_t
+      lhs_size () const
+      {
+        return lhs_size_;
+      }
+
+      [[nodiscard]] std::size_t
+      rhs_size () const
+      {
+        return rhs_size_;
+      }
+
+      [[nodiscard]] double
+      rel_tol () const
+      {
+        return rel_tol_;
+      }
+
+      [[nodiscard]] double
+      abs_tol () const
+      {
+        return abs_tol_;
+      }
+
+      [[nodiscard]] std::uint64_t
+      max_ulps () const
+      {
+        return max_ulps_;
+      }
+
+      [[nodiscard]] const close_result&
+      result () const
+      {
+        return result_;
+      }
+
+      const char* const type_name_{};
+      const std::size_t lhs_size_{};
+      const std::size_t rhs_size_{};
+      const double rel_tol_{};
+      const double abs_tol_{};
+      const std::uint64_t max_ulps_{};
+      const close_result result_{};
+      const bool value_{};
+    };
+
+    /**
+     * @brief The result of a property, with the minimal counterexample.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     *
+     * @details
+     * The values have different types for each property; they are
+     * displayed by a function instantiated together with the property,
+     * so that the reporter needs a single non-template operator.
+     */
+    struct property_ : type_traits::op
+    {
+      using print_function_t = void (*) (test_reporter& reporter,
+                                         const void* values);
+
+      [[nodiscard]] constexpr
+      operator bool () const
+      {
+        return value_;
+      }
+
+      const bool value_{};
+      const std::size_t tests_{};
+      const std::size_t shrinks_{};
+      const std::uint64_t seed_{};
+      const void* const values_{};
+      const print_function_t print_{};
+    };
+
+    /**
+     * @brief The results of the iterations executed by one thread
+     * of a stress() test.
+     */
+    struct stress_thread_
+    {
+      std::size_t failures;
+      std::uint64_t elapsed_ns;
+    };
+
+    /**
+     * @brief The result of a stress() test.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     */
+    struct stress_ : type_traits::op
+    {
+      [[nodiscard]] constexpr
+      operator bool () const
+      {
+        return value_;
+      }
+
+      const bool value_{};
+      const std::size_t iterations_{};
+      // The checks that failed in the threads, while running.
+      const std::size_t failed_checks_{};
+      const std::uint64_t elapsed_ns_{};
+      const std::vector<stress_thread_> threads_{};
+    };
+
+    /**
+     * @brief The result of an explore() test.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     *
+     * @details
+     * For failures, the schedule is the list of threads chosen at
+     * each scheduling point with more than one choice, as
+     * a string like `0.1.1.0`.
+     */
+    struct explore_ : type_traits::op
+    {
+      /**
+       * @brief The reason of the failure.
+       */
+      enum class failure : std::uint8_t
+      {
+        none,
+        body, // A thread body returned false.
+        checks, // Checks failed in the threads.
+        check, // The final check returned false.
+        deadlock, // All threads were blocked.
+        steps, // Too many scheduling points in a schedule.
+      };
+
+      [[nodiscard]] constexpr
+      operator bool () const
+      {
+        return value_;
+      }
+
+      const bool value_{};
+      const failure failure_{};
+      const std::size_t threads_{};
+      // The number of schedules executed, including the failing one.
+      const std::size_t schedules_{};
+      // The limit of the number of schedules, 0 for no limit.
+      const std::size_t max_schedules_{};
+      // True if all schedules within the preemption bound were explored.
+      const bool exhausted_{};
+      const bool random_{};
+      const bool replay_{};
+      const std::size_t preemption_bound_{};
+      // Of the failing schedule.
+      const std::size_t preemptions_{};
+      const std::size_t failed_checks_{};
+      const std::string schedule_{};
+    };
+
+    /**
+     * @brief The result of a linearizable() check of a history.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     *
+     * @details
+     * For failures, the operation that could not be ordered and
+     * its result are displayed by functions instantiated with the
+     * history, like for property_.
+     */
+    struct linearizable_ : type_traits::op
+    {
+      using print_function_t = void (*) (test_reporter& reporter,
+                                         const void* value);
+
+      [[nodiscard]] constexpr
+      operator bool () const
+      {
+        return value_;
+      }
+
+      const bool value_{};
+      // True if the search was stopped after `max_states`.
+      const bool gave_up_{};
+      const std::size_t operations_{};
+      const std::size_t pending_{};
+      // Operations not recorded, because the history was full.
+      const std::size_t dropped_{};
+      const std::size_t states_{};
+      // The most operations ordered in a valid sequence.
+      const std::size_t longest_{};
+      const std::size_t thread_{};
+      const void* const operation_{};
+      const print_function_t print_operation_{};
+      const void* const result_{};
+      const print_function_t print_result_{};
+    };
+
+    /**
+     * @brief The result of a mock::called() expectation.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     */
+    struct mock_called_ : type_traits::op
+    {
+      [[nodiscard]] constexpr
+      operator bool () const
+      {
+        return value_;
+      }
+
+      const bool value_{};
+      const mock::method_base* const method_{};
+      const std::size_t expected_{};
+      const std::size_t actual_{};
+      // True if the arguments were checked with matchers.
+      const bool matched_{};
+      // Calls not recorded, because the call log was full.
+      const std::size_t dropped_{};
+    };
+
+    /**
+     * @brief The result of a mock::in_order() expectation.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     */
+    struct mock_in_order_ : type_traits::op
+    {
+      [[nodiscard]] constexpr
+      operator bool () const
+      {
+        return value_;
+      }
+
+      const bool value_{};
+      const std::size_t calls_{};
+      // The index of the first call not found, for failures.
+      const std::size_t missing_{};
+      const mock::method_base* const method_{};
+      const std::size_t dropped_{};
+    };
+
+    /**
+     * @brief The result of a row of a table_case().
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     *
+     * @details
+     * The row and the result returned by the body are displayed
+     * by functions instantiated once for each table type.
+     */
+    struct table_row_ : type_traits::op
+    {
+      using print_function_t = void (*) (test_reporter& reporter,
+                                         const void* object);
+
+      [[nodiscard]] constexpr
+      operator bool () const
+      {
+        return value_;
+      }
+
+      const bool value_{};
+      const std::size_t index_{};
+      const std::size_t rows_{};
+      const void* const row_{};
+      const print_function_t print_row_{};
+      const void* const result_{};
+      const print_function_t print_result_{};
+    };
+
+    /**
+     * @brief The statistics of a set of combinations().
+     */
+    struct combinations_coverage
+    {
+      std::size_t cases = 0;
+      std::size_t product = 0;
+      std::size_t strength = 0;
+      std::size_t covered = 0;
+      std::size_t tuples = 0;
+    };
+
+    /**
+     * @brief Compute a covering array with a greedy algorithm.
+     * @param [in] sizes The number of values of each parameter.
+     * @param [in] parameters The number of parameters.
+     * @param [in] strength The size of the parameter tuples
+     * to cover, 2 for all pairs.
+     * @param [in] max_cases The maximum number of rows, 0 for no limit.
+     * @param [out] rows The value indices, `parameters` for each row.
+     * @return The coverage statistics.
+     */
+    combinations_coverage
+    covering_array (const std::size_t* sizes, std::size_t parameters,
+                    std::size_t strength, std::size_t max_cases,
+                    std::vector<std::size_t>& rows);
+
+    // ------------------------------------------------------------------------
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+    /**
+     * @brief Set only in the thread which called `initialize()`, and
+     * executes the test cases; cached, since it is checked twice
+     * for each check.
+     */
+    extern thread_local constinit bool in_runner_thread;
+
+    /**
+     * @brief Check if the caller is the thread which executes the
+     * test cases; the checks issued by other threads are accounted
+     * separately and merged at the end of the test case.
+     */
+    [[nodiscard]] inline bool
+    is_runner_thread (void)
+    {
+      return in_runner_thread;
+    }
+
+    /**
+     * @brief Remember where the message of a check issued by the
+     * runner thread starts in the reporter buffer, with a sequence
+     * number, to merge the messages of the other threads in order.
+     */
+    void
+    mark_runner_check (void);
+
+    /**
+     * @brief Count a check issued by another thread, in the
+     * counters of that thread.
+     */
+    void
+    count_worker_check (bool value);
+
+    /**
+     * @brief Get the reporter of the current thread, used for the
+     * checks issued by other threads than the runner thread.
+     */
+    test_reporter&
+    worker_reporter (void);
+
+    /**
+     * @brief Move the output of the current thread reporter to the
+     * buffer of the thread, to be displayed at the end of the test
+     * case; it does not wait for other threads. The output of the
+     * failed checks is never dropped.
+     */
+    void
+    release_worker_reporter (bool value);
+
+    /**
+     * @brief Add the counters and the output of the other threads
+     * to the current test case; called by `end_test_case()`.
+     */
+    void
+    merge_worker_checks (test_suite_base& suite);
+
+    /**
+     * @brief Display the messages of the other threads not yet merged;
+     * called when a failed assumption in another thread than the
+     * runner thread aborts the process.
+     */
+    void
+    output_worker_checks (void);
+
+    /**
+     * @brief The number of checks issued by other threads which
+     * failed and were not yet merged.
+     */
+    std::size_t
+    worker_failed_checks (void);
+#endif // defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
+    // ------------------------------------------------------------------------
+
     /**
      * @brief Base class for a deferred reporter, that collects the
      * messages into a string.
@@ -699,10 +1464,11 @@ namespace micro_os_plus::micro_test_plus
     class deferred_reporter_base
     {
     public:
-      deferred_reporter_base (bool value,
-                              const reflection::source_location location);
-
-      ~deferred_reporter_base ();
+      constexpr deferred_reporter_base (
+          bool value, const reflection::source_location location)
+          : value_{ value }, location_{ location }
+      {
+      }
 
       template <class T>
       auto&
@@ -715,6 +1481,44 @@ namespace micro_os_plus::micro_test_plus
       }
 
     protected:
+      /**
+       * @brief Function displaying a passed check, with the type
+       * of the expression erased.
+       */
+      using pass_output_t
+          = void (*) (test_reporter& stream, const void* expr,
+                      std::string& message);
+
+      /**
+       * @brief Function displaying a failed check, with the type
+       * of the expression erased.
+       */
+      using fail_output_t = void (*) (
+          test_reporter& stream, const void* expr, bool abort,
+          std::string& message, const reflection::source_location& location);
+
+      /**
+       * @brief Count a passed check issued by the runner thread;
+       * return true if it must also be reported, since it is
+       * displayed or it was issued by another thread.
+       */
+      [[nodiscard, gnu::always_inline]] inline bool
+      count_pass_ (void);
+
+      /**
+       * @brief Report a passed check, displayed or issued by
+       * another thread than the runner thread.
+       */
+      [[gnu::noinline]] void
+      report_pass_ (const void* expr, pass_output_t output);
+
+      /**
+       * @brief Count and display a failed check; abort if the
+       * check is an assumption.
+       */
+      [[gnu::cold, gnu::noinline]] void
+      report_fail_ (const void* expr, fail_output_t output);
+
       bool value_{};
       bool abort_ = false;
       const reflection::source_location location_{};
@@ -739,12 +1543,335 @@ namespace micro_os_plus::micro_test_plus
           const Expr_T& expr, bool abort,
           const reflection::source_location& location);
 
-      ~deferred_reporter ();
+      [[gnu::always_inline]] inline ~deferred_reporter ();
 
     protected:
+      // Only referred via pointers, by the out of line report
+      // functions; cold, thus optimised for size, since formatting
+      // the expression is anyway much slower than the check.
+      [[gnu::cold]] static void
+      output_pass_ (test_reporter& stream, const void* expr,
+                    std::string& message);
+
+      [[gnu::cold]] static void
+      output_fail_ (test_reporter& stream, const void* expr, bool abort,
+                    std::string& message,
+                    const reflection::source_location& location);
+
       const Expr_T expr_{};
     };
 
+    // ------------------------------------------------------------------------
+    // Lite mode.
+
+    /**
+     * @brief The operators known to the lite mode.
+     */
+    enum class lite_op : std::uint8_t
+    {
+      none,
+      eq,
+      ne,
+      lt,
+      le,
+      gt,
+      ge,
+      and_,
+      or_,
+      not_,
+      throws,
+      nothrow
+    };
+
+    /**
+     * @brief An operand value, with its type reduced to a few kinds.
+     */
+    struct lite_operand
+    {
+      enum class kind : std::uint8_t
+      {
+        none,
+        boolean,
+        character,
+        signed_integer,
+        unsigned_integer,
+        floating_point,
+        pointer,
+        string,
+        opaque
+      };
+
+      kind kind_ = kind::none;
+      std::size_t length_ = 0;
+      union
+      {
+        long long signed_integer;
+        unsigned long long unsigned_integer;
+        double floating_point;
+        const void* pointer;
+        const char* string;
+      } value_{};
+    };
+
+    /**
+     * @brief A type-erased expression, with the result, the operator
+     * and the operands, used by the lite mode instead of the
+     * actual expressions.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     */
+    struct lite_expression : type_traits::op
+    {
+      [[nodiscard]] constexpr
+      operator bool () const
+      {
+        return value_;
+      }
+
+      bool value_ = false;
+      lite_op op_ = lite_op::none;
+      lite_operand lhs_{};
+      lite_operand rhs_{};
+    };
+
+    /**
+     * @brief Map the operators types to the lite mode tags;
+     * the expressions with the `none` tag are not erased.
+     */
+    template <class T>
+    struct lite_traits
+    {
+      static constexpr lite_op op = lite_op::none;
+    };
+
+    template <class Lhs_T, class Rhs_T>
+    struct lite_traits<eq_<Lhs_T, Rhs_T>>
+    {
+      static constexpr lite_op op = lite_op::eq;
+    };
+
+    template <class Lhs_T, class Rhs_T>
+    struct lite_traits<ne_<Lhs_T, Rhs_T>>
+    {
+      static constexpr lite_op op = lite_op::ne;
+    };
+
+    template <class Lhs_T, class Rhs_T>
+    struct lite_traits<lt_<Lhs_T, Rhs_T>>
+    {
+      static constexpr lite_op op = lite_op::lt;
+    };
+
+    template <class Lhs_T, class Rhs_T>
+    struct lite_traits<le_<Lhs_T, Rhs_T>>
+    {
+      static constexpr lite_op op = lite_op::le;
+    };
+
+    template <class Lhs_T, class Rhs_T>
+    struct lite_traits<gt_<Lhs_T, Rhs_T>>
+    {
+      static constexpr lite_op op = lite_op::gt;
+    };
+
+    template <class Lhs_T, class Rhs_T>
+    struct lite_traits<ge_<Lhs_T, Rhs_T>>
+    {
+      static constexpr lite_op op = lite_op::ge;
+    };
+
+    template <class Lhs_T, class Rhs_T>
+    struct lite_traits<and_<Lhs_T, Rhs_T>>
+    {
+      static constexpr lite_op op = lite_op::and_;
+    };
+
+    template <class Lhs_T, class Rhs_T>
+    struct lite_traits<or_<Lhs_T, Rhs_T>>
+    {
+      static constexpr lite_op op = lite_op::or_;
+    };
+
+    template <class T>
+    struct lite_traits<not_<T>>
+    {
+      static constexpr lite_op op = lite_op::not_;
+    };
+
+#if defined(__cpp_exceptions)
+    template <class Callable_T, class Exception_T>
+    struct lite_traits<throws_<Callable_T, Exception_T>>
+    {
+      static constexpr lite_op op = lite_op::throws;
+      using exception_type = Exception_T;
+    };
+
+    template <class Callable_T>
+    struct lite_traits<nothrow_<Callable_T>>
+    {
+      static constexpr lite_op op = lite_op::nothrow;
+    };
+#endif
+
+    template <class T>
+    inline constexpr bool is_lite_v = lite_traits<T>::op != lite_op::none;
+
+    /**
+     * @brief Reduce a value to a lite operand.
+     */
+    template <class T>
+    [[nodiscard]] constexpr lite_operand
+    make_lite_operand (const T& v)
+    {
+      using kind = lite_operand::kind;
+      lite_operand operand{};
+      if constexpr (std::is_same_v<T, bool>)
+        {
+          operand.kind_ = kind::boolean;
+          operand.value_.unsigned_integer = v;
+        }
+      else if constexpr (std::is_same_v<T, char>)
+        {
+          operand.kind_ = kind::character;
+          operand.value_.signed_integer = v;
+        }
+      else if constexpr (std::is_integral_v<T> and std::is_signed_v<T>)
+        {
+          operand.kind_ = kind::signed_integer;
+          operand.value_.signed_integer = v;
+        }
+      else if constexpr (std::is_integral_v<T>)
+        {
+          operand.kind_ = kind::unsigned_integer;
+          operand.value_.unsigned_integer = v;
+        }
+      else if constexpr (std::is_enum_v<T>)
+        {
+          operand.kind_ = kind::signed_integer;
+          operand.value_.signed_integer = static_cast<long long> (v);
+        }
+      else if constexpr (std::is_floating_point_v<T>)
+        {
+          operand.kind_ = kind::floating_point;
+          operand.value_.floating_point = static_cast<double> (v);
+        }
+      else if constexpr (std::is_null_pointer_v<T>)
+        {
+          operand.kind_ = kind::pointer;
+          operand.value_.pointer = nullptr;
+        }
+      else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+          if constexpr (std::is_pointer_v<T>)
+            {
+              if (v == nullptr)
+                {
+                  operand.kind_ = kind::pointer;
+                  operand.value_.pointer = nullptr;
+                  return operand;
+                }
+            }
+          const std::string_view sv{ v };
+          operand.kind_ = kind::string;
+          operand.value_.string = sv.data ();
+          operand.length_ = sv.size ();
+        }
+      else if constexpr (std::is_pointer_v<T>)
+        {
+          operand.kind_ = kind::pointer;
+          operand.value_.pointer = reinterpret_cast<const void*> (v);
+        }
+      else
+        {
+          // Containers, nested expressions, custom types.
+          operand.kind_ = kind::opaque;
+        }
+      return operand;
+    }
+
+    /**
+     * @brief Tag for the operands that cannot be erased.
+     */
+    struct lite_opaque
+    {
+    };
+
+    /**
+     * @brief Select what to reduce from a stored operand.
+     *
+     * @details
+     * The strings are erased to pointers, thus they are taken
+     * from the operand stored in the expression, which lives until
+     * the end of the full expression, when the report is created;
+     * the getters return copies, so the strings they return
+     * (possibly from wrappers) cannot be kept.
+     */
+    template <class T>
+    [[nodiscard]] constexpr decltype (auto)
+    lite_operand_source (const T& stored)
+    {
+      using value_type = decltype (get (stored));
+      if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+          return stored;
+        }
+      else if constexpr (std::is_class_v<value_type>
+                         and not std::is_same_v<value_type, std::string_view>
+                         and std::is_convertible_v<const value_type&,
+                                                   std::string_view>)
+        {
+          return lite_opaque{};
+        }
+      else
+        {
+          return get (stored);
+        }
+    }
+
+    /**
+     * @brief Reduce an expression to a lite expression.
+     */
+    template <class Expr_T>
+    [[nodiscard]] constexpr lite_expression
+    make_lite_expression (const Expr_T& expr)
+    {
+      using traits = lite_traits<Expr_T>;
+      lite_expression lite{};
+      lite.value_ = static_cast<bool> (expr);
+      lite.op_ = traits::op;
+      if constexpr (traits::op == lite_op::and_ or traits::op == lite_op::or_)
+        {
+          // Nested expressions are reduced to their results.
+          lite.lhs_ = make_lite_operand (static_cast<bool> (expr.lhs ()));
+          lite.rhs_ = make_lite_operand (static_cast<bool> (expr.rhs ()));
+        }
+      else if constexpr (traits::op == lite_op::not_)
+        {
+          lite.lhs_ = make_lite_operand (static_cast<bool> (expr.value ()));
+        }
+#if defined(__cpp_exceptions)
+      else if constexpr (traits::op == lite_op::throws)
+        {
+          if constexpr (not std::is_void_v<typename traits::exception_type>)
+            {
+              lite.lhs_ = make_lite_operand (
+                  reflection::type_name<typename traits::exception_type> ());
+            }
+        }
+#endif
+      else if constexpr (traits::op != lite_op::nothrow)
+        {
+          lite.lhs_ = make_lite_operand (lite_operand_source (expr.lhs_));
+          lite.rhs_ = make_lite_operand (lite_operand_source (expr.rhs_));
+        }
+      return lite;
+    }
+
+#if defined(MICRO_TEST_PLUS_LITE)
+    // The only reporter used for the erased expressions is
+    // instantiated once, in the library.
+    extern template class deferred_reporter<lite_expression>;
+#endif
+
     // ----------------------------------------------------------------------
   } // namespace detail
 
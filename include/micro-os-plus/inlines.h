@@ -50,6 +50,31 @@ namespace micro_os_plus::micro_test_plus
     runner.register_test_suite (this);
   }
 
+  template <typename Callable_T>
+  registered_test_case<Callable_T>::registered_test_case (
+      const char* name, Callable_T callable, const char* tags,
+      const reflection::source_location& sl)
+      : test_case_descriptor{ nullptr, name, tags, sl },
+        callable_{ std::move (callable) }
+  {
+  }
+
+  template <typename Callable_T>
+  registered_test_case<Callable_T>::registered_test_case (
+      test_suite_base& suite, const char* name, Callable_T callable,
+      const char* tags, const reflection::source_location& sl)
+      : test_case_descriptor{ &suite, name, tags, sl },
+        callable_{ std::move (callable) }
+  {
+  }
+
+  template <typename Callable_T>
+  void
+  registered_test_case<Callable_T>::run (void)
+  {
+    callable_ ();
+  }
+
   // --------------------------------------------------------------------------
 
   /**
@@ -90,10 +115,63 @@ namespace micro_os_plus::micro_test_plus
     printf ("%s\n", __PRETTY_FUNCTION__);
 #endif // MICRO_TEST_PLUS_TRACE
 
-    current_test_suite->begin_test_case (name);
-    std::invoke (std::forward<Callable_T> (callable),
-                 std::forward<Args_T> (arguments)...);
-    current_test_suite->end_test_case ();
+    if (current_test_suite->begin_test_case (name))
+      {
+        std::invoke (std::forward<Callable_T> (callable),
+                     std::forward<Args_T> (arguments)...);
+        current_test_suite->end_test_case ();
+      }
+  }
+
+  namespace detail
+  {
+    template <class T, typename Callable_T>
+    void
+    typed_test_case (const char* name, Callable_T& callable)
+    {
+      // The name must be valid until the end of the test case.
+      std::string typed_name{ name };
+      typed_name.append (" (");
+      typed_name.append (reflection::type_name<T> ());
+      typed_name.append (")");
+
+      if (current_test_suite->begin_test_case (typed_name.c_str ()))
+        {
+          callable.template operator()<T> ();
+          current_test_suite->end_test_case ();
+        }
+    }
+
+    template <typename Callable_T, class... Types_T>
+    void
+    typed_test_cases (const char* name, Callable_T& callable,
+                      type_traits::list<Types_T...>)
+    {
+      (typed_test_case<Types_T> (name, callable), ...);
+    }
+  } // namespace detail
+
+  /**
+   * @details
+   * The callable is instantiated and invoked once for each type,
+   * each time as a separate test case.
+   *
+   * @par Example
+   *
+   * ```cpp
+   *   namespace mt = micro_os_plus::micro_test_plus;
+   *
+   *   mt::test_case<mt::type_traits::list<int8_t, int32_t, float>> (
+   *       "Check sum", []<class T> () {
+   *         mt::expect (mt::eq (sum<T> ({ 1, 2 }), T{ 3 }));
+   *       });
+   * ```
+   */
+  template <class List_T, typename Callable_T>
+  void
+  test_case (const char* name, Callable_T&& callable)
+  {
+    detail::typed_test_cases (name, callable, List_T{});
   }
 
   // --------------------------------------------------------------------------
@@ -131,19 +209,63 @@ namespace micro_os_plus::micro_test_plus
       abort_ = abort;
     }
 
+    bool
+    deferred_reporter_base::count_pass_ (void)
+    {
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+      if (not is_runner_thread ()) [[unlikely]]
+        {
+          return true;
+        }
+#endif
+      current_test_suite->increment_successful ();
+      reporter.last_pass = location_;
+      return reporter.displays_passes ();
+    }
+
+    /**
+     * @details
+     * Forced inline, a passed check only compares, counts and
+     * remembers its location in the test body; the expression is
+     * formatted out of line, and only when displayed. The failed
+     * checks go to a single cold function, with the expression
+     * type erased.
+     */
     template <class Expr_T>
     deferred_reporter<Expr_T>::~deferred_reporter ()
     {
-      if (value_)
+      if (value_) [[likely]]
         {
-          reporter.pass (expr_, message_);
+          if (count_pass_ ())
+            {
+              report_pass_ (&expr_, &output_pass_);
+            }
         }
       else
         {
-          reporter.fail (expr_, abort_, message_, location_);
+          report_fail_ (&expr_, &output_fail_);
         }
     }
 
+    template <class Expr_T>
+    void
+    deferred_reporter<Expr_T>::output_pass_ (test_reporter& stream,
+                                             const void* expr,
+                                             std::string& message)
+    {
+      stream.pass (*static_cast<const Expr_T*> (expr), message);
+    }
+
+    template <class Expr_T>
+    void
+    deferred_reporter<Expr_T>::output_fail_ (
+        test_reporter& stream, const void* expr, bool abort,
+        std::string& message, const reflection::source_location& location)
+    {
+      stream.fail (*static_cast<const Expr_T*> (expr), abort, message,
+                   location);
+    }
+
     // ------------------------------------------------------------------------
   } // namespace detail
 
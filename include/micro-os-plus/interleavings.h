@@ -0,0 +1,483 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+#ifndef MICRO_TEST_PLUS_INTERLEAVINGS_H_
+#define MICRO_TEST_PLUS_INTERLEAVINGS_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wc++98-c++11-c++14-c++17-compat-pedantic"
+#endif
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  /**
+   * @ingroup micro-test-plus-function-comparators
+   * @brief Options for explore().
+   * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+   */
+  struct explore_options
+  {
+    /**
+     * @brief The maximum number of preemptions in a schedule, i.e.
+     * of switches away from a thread that could continue.
+     */
+    std::size_t preemption_bound = 2;
+
+    /**
+     * @brief The maximum number of schedules to run, 0 for no limit.
+     */
+    std::size_t max_schedules = 10000;
+
+    /**
+     * @brief The maximum number of scheduling points in a schedule,
+     * to detect livelocks.
+     */
+    std::size_t max_steps = 10000;
+
+    /**
+     * @brief Choose the threads randomly, instead of exploring
+     * the schedules systematically.
+     */
+    bool random = false;
+
+    /**
+     * @brief The seed of the random choices; 0 to use the one
+     * given with `--seed=N`, or a constant.
+     */
+    std::uint64_t seed = 0;
+
+    /**
+     * @brief A schedule reported by a failed run, like `0.1.1.0`,
+     * to run it again, alone.
+     */
+    const char* schedule = nullptr;
+  };
+
+  namespace detail
+  {
+    /**
+     * @brief The type-erased callables of an explore() test.
+     */
+    struct explore_callables
+    {
+      void (*setup) (void* callable);
+      void* setup_callable;
+      bool (*body) (void* callable, std::size_t thread);
+      void* body_callable;
+      bool (*check) (void* callable);
+      void* check_callable;
+    };
+
+    /**
+     * @brief Run the schedules and collect the result.
+     */
+    explore_
+    run_explore (std::size_t threads, const explore_callables& callables,
+                 const explore_options& options);
+
+    /**
+     * @brief True if the current thread runs under the control
+     * of explore().
+     */
+    [[nodiscard]] bool
+    is_exploring (void);
+
+    /**
+     * @brief A point where the scheduler may switch to another thread.
+     * @param [in] voluntary True if the thread prefers to let the
+     * others run, like when spinning; then the switch does not count
+     * as a preemption.
+     */
+    void
+    schedule_point (bool voluntary);
+
+    /**
+     * @brief Wait until the object is released by another thread.
+     * @retval true The object was released.
+     * @retval false The schedule is aborted (after a deadlock),
+     * and the threads must continue without waiting.
+     */
+    bool
+    schedule_block (const void* object);
+
+    /**
+     * @brief Make runnable the threads waiting for the object.
+     */
+    void
+    schedule_release (const void* object);
+
+    template <class Callable_T>
+    void
+    invoke_explore_setup (void* callable)
+    {
+      (*static_cast<Callable_T*> (callable)) ();
+    }
+
+    template <class Callable_T>
+    bool
+    invoke_explore_body (void* callable, std::size_t thread)
+    {
+      Callable_T& body = *static_cast<Callable_T*> (callable);
+      if constexpr (std::is_invocable_v<Callable_T&, std::size_t>)
+        {
+          if constexpr (std::is_void_v<
+                            std::invoke_result_t<Callable_T&, std::size_t>>)
+            {
+              body (thread);
+              return true;
+            }
+          else
+            {
+              return static_cast<bool> (body (thread));
+            }
+        }
+      else
+        {
+          if constexpr (std::is_void_v<std::invoke_result_t<Callable_T&>>)
+            {
+              body ();
+              return true;
+            }
+          else
+            {
+              return static_cast<bool> (body ());
+            }
+        }
+    }
+
+    template <class Callable_T>
+    bool
+    invoke_explore_check (void* callable)
+    {
+      Callable_T& check = *static_cast<Callable_T*> (callable);
+      if constexpr (std::is_void_v<std::invoke_result_t<Callable_T&>>)
+        {
+          check ();
+          return true;
+        }
+      else
+        {
+          return static_cast<bool> (check ());
+        }
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+
+  /**
+   * @brief Instrumented synchronisation primitives, which let
+   * explore() switch threads at each operation.
+   *
+   * @details
+   * Outside explore() they behave like the standard ones, with
+   * only a test for the current thread added.
+   */
+  namespace interleavings
+  {
+    /**
+     * @brief Let the other threads run; to be called in spinning
+     * loops, otherwise they never end under explore().
+     */
+    inline void
+    yield (void)
+    {
+      detail::schedule_point (true);
+    }
+
+    /**
+     * @brief An atomic variable with a scheduling point before
+     * each operation.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     *
+     * @details
+     * The threads run one at a time, thus only sequentially
+     * consistent executions are explored; the memory orders are
+     * passed to the standard atomic.
+     */
+    template <class T>
+    class atomic
+    {
+    public:
+      atomic () = default;
+
+      constexpr atomic (T value) : value_{ value }
+      {
+      }
+
+      atomic (const atomic&) = delete;
+      atomic&
+      operator= (const atomic&)
+          = delete;
+
+      T
+      load (std::memory_order order = std::memory_order_seq_cst) const
+      {
+        detail::schedule_point (false);
+        return value_.load (order);
+      }
+
+      void
+      store (T value, std::memory_order order = std::memory_order_seq_cst)
+      {
+        detail::schedule_point (false);
+        value_.store (value, order);
+      }
+
+      T
+      exchange (T value, std::memory_order order = std::memory_order_seq_cst)
+      {
+        detail::schedule_point (false);
+        return value_.exchange (value, order);
+      }
+
+      bool
+      compare_exchange_strong (
+          T& expected, T desired,
+          std::memory_order order = std::memory_order_seq_cst)
+      {
+        detail::schedule_point (false);
+        return value_.compare_exchange_strong (expected, desired, order);
+      }
+
+      bool
+      compare_exchange_weak (T& expected, T desired,
+                             std::memory_order order
+                             = std::memory_order_seq_cst)
+      {
+        detail::schedule_point (false);
+        return value_.compare_exchange_weak (expected, desired, order);
+      }
+
+      T
+      fetch_add (T value, std::memory_order order = std::memory_order_seq_cst)
+      {
+        detail::schedule_point (false);
+        return value_.fetch_add (value, order);
+      }
+
+      T
+      fetch_sub (T value, std::memory_order order = std::memory_order_seq_cst)
+      {
+        detail::schedule_point (false);
+        return value_.fetch_sub (value, order);
+      }
+
+      operator T () const
+      {
+        return load ();
+      }
+
+      T
+      operator= (T value)
+      {
+        store (value);
+        return value;
+      }
+
+    protected:
+      std::atomic<T> value_{};
+    };
+
+    /**
+     * @brief A mutex which, under explore(), blocks only the
+     * simulated thread, so that the scheduler can detect deadlocks.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     *
+     * @details
+     * It meets the _Lockable_ requirements, thus it can be used with
+     * `std::lock_guard` and `std::unique_lock`.
+     */
+    class mutex
+    {
+    public:
+      mutex () = default;
+
+      mutex (const mutex&) = delete;
+      mutex&
+      operator= (const mutex&)
+          = delete;
+
+      void
+      lock (void)
+      {
+        if (not detail::is_exploring ())
+          {
+            mutex_.lock ();
+            return;
+          }
+        detail::schedule_point (false);
+        while (locked_ and detail::schedule_block (this))
+          {
+            ;
+          }
+        locked_ = true;
+      }
+
+      bool
+      try_lock (void)
+      {
+        if (not detail::is_exploring ())
+          {
+            return mutex_.try_lock ();
+          }
+        detail::schedule_point (false);
+        if (locked_)
+          {
+            return false;
+          }
+        locked_ = true;
+        return true;
+      }
+
+      void
+      unlock (void)
+      {
+        if (not detail::is_exploring ())
+          {
+            mutex_.unlock ();
+            return;
+          }
+        locked_ = false;
+        detail::schedule_release (this);
+        detail::schedule_point (false);
+      }
+
+    protected:
+      std::mutex mutex_{};
+      // Under explore() the threads run one at a time, thus
+      // a simple flag is enough.
+      bool locked_ = false;
+    };
+  } // namespace interleavings
+
+  // --------------------------------------------------------------------------
+
+  /**
+   * @ingroup micro-test-plus-function-comparators
+   * @brief Run some threads under a scheduler which explores their
+   * interleavings, switching threads at the operations of the
+   * instrumented atomics and mutexes.
+   * @tparam Setup_T The type of the setup.
+   * @tparam Body_T The type of the thread body.
+   * @tparam Check_T The type of the final check.
+   * @param [in] threads The number of threads.
+   * @param [in] setup Invoked before each schedule, to initialise
+   * the shared state.
+   * @param [in] body Invoked by each thread, as `body (thread)` or
+   * `body ()`, returning a boolean or nothing.
+   * @param [in] check Invoked after the threads end, returning
+   * a boolean or nothing.
+   * @param [in] options The options.
+   * @return An operation to be checked with expect() or assume().
+   *
+   * @details
+   * The threads run one at a time, passing control to each other only
+   * at the scheduling points of the `interleavings::atomic`,
+   * `interleavings::mutex` and `interleavings::yield()`, thus each
+   * schedule is deterministic.
+   *
+   * By default the schedules are explored depth first, each one
+   * differing from the previous one in the last choice, with at most
+   * `preemption_bound` preemptions; most concurrency bugs need
+   * only one or two preemptions to show up. With `random` set, the
+   * threads are chosen randomly, for `max_schedules` runs.
+   *
+   * The exploration stops at the first schedule in which a body
+   * returns false, a check issued by the threads fails, the final
+   * check returns false, all threads are blocked (a deadlock),
+   * or there are more than `max_steps` scheduling points
+   * (a livelock). The failing schedule is displayed, and can be
+   * passed back in `schedule` to run it again.
+   *
+   * After a deadlock, the threads are run to the end without
+   * blocking on the mutexes, one at a time.
+   *
+   * Available when `MICRO_TEST_PLUS_THREAD_SAFE` is defined.
+   *
+   * @par Example
+   *
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   *
+   * mt::interleavings::atomic<int> counter;
+   * mt::expect (mt::explore (
+   *     2, [&] { counter.store (0); },
+   *     [&] { counter.store (counter.load () + 1); },
+   *     [&] { return counter.load () == 2; }))
+   *     << "no lost updates";
+   * ```
+   */
+  template <class Setup_T, class Body_T, class Check_T>
+  [[nodiscard]] detail::explore_
+  explore (std::size_t threads, Setup_T&& setup, Body_T&& body,
+           Check_T&& check, const explore_options& options = {})
+  {
+    using setup_t = std::remove_const_t<std::remove_reference_t<Setup_T>>;
+    using body_t = std::remove_const_t<std::remove_reference_t<Body_T>>;
+    using check_t = std::remove_const_t<std::remove_reference_t<Check_T>>;
+
+    const detail::explore_callables callables{
+      &detail::invoke_explore_setup<setup_t>,
+      const_cast<setup_t*> (std::addressof (setup)),
+      &detail::invoke_explore_body<body_t>,
+      const_cast<body_t*> (std::addressof (body)),
+      &detail::invoke_explore_check<check_t>,
+      const_cast<check_t*> (std::addressof (check))
+    };
+    return detail::run_explore (threads, callables, options);
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_TEST_PLUS_INTERLEAVINGS_H_
+
+// ----------------------------------------------------------------------------
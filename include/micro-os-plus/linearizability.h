@@ -0,0 +1,485 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+#ifndef MICRO_TEST_PLUS_LINEARIZABILITY_H_
+#define MICRO_TEST_PLUS_LINEARIZABILITY_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
+#if !defined(__clang__) // GCC only
+#pragma GCC diagnostic ignored "-Wsuggest-final-types"
+#pragma GCC diagnostic ignored "-Wsuggest-final-methods"
+#endif
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wc++98-c++11-c++14-c++17-compat-pedantic"
+#endif
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  /**
+   * @ingroup micro-test-plus-function-comparators
+   * @brief A history of the operations executed concurrently on
+   * a shared object, to be checked with linearizable().
+   * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+   * @tparam Operation_T The type of the operations, with the
+   * arguments; it must be default constructible.
+   * @tparam Result_T The type of the results; it must be default
+   * constructible and comparable.
+   *
+   * @details
+   * The entries are preallocated; recording an operation takes
+   * an entry and two timestamps with atomic increments, thus the
+   * threads do not wait for each other. If the history is full,
+   * the operations are only counted.
+   *
+   * The timestamps are taken from a logical clock, incremented when
+   * each operation is invoked and when it returns, which is enough
+   * to know which operations overlap.
+   *
+   * The history must be read only after the threads are joined.
+   */
+  template <class Operation_T, class Result_T>
+  class history
+  {
+  public:
+    /**
+     * @brief A recorded operation.
+     */
+    struct entry
+    {
+      Operation_T operation;
+      Result_T result;
+      std::size_t thread;
+      std::size_t invoked;
+      // 0 if the operation did not return.
+      std::size_t returned;
+    };
+
+    /**
+     * @brief The identifier of operations not recorded.
+     */
+    static constexpr std::size_t npos
+        = std::numeric_limits<std::size_t>::max ();
+
+    /**
+     * @brief Construct a history.
+     * @param [in] capacity The maximum number of operations.
+     */
+    explicit history (std::size_t capacity) : entries_ (capacity)
+    {
+    }
+
+    history (const history&) = delete;
+    history (history&&) = delete;
+    history&
+    operator= (const history&)
+        = delete;
+    history&
+    operator= (history&&)
+        = delete;
+
+    ~history () = default;
+
+    /**
+     * @brief Record the invocation of an operation.
+     * @param [in] thread The thread index, for the report.
+     * @param [in] operation The operation.
+     * @return The identifier, to be passed to `response()`.
+     */
+    std::size_t
+    invoke (std::size_t thread, const Operation_T& operation)
+    {
+      const std::size_t id = size_.fetch_add (1, std::memory_order_relaxed);
+      if (id >= entries_.size ())
+        {
+          dropped_.fetch_add (1, std::memory_order_relaxed);
+          return npos;
+        }
+      entry& e = entries_[id];
+      e.operation = operation;
+      e.thread = thread;
+      e.returned = 0;
+      e.invoked = clock_.fetch_add (1) + 1;
+      return id;
+    }
+
+    /**
+     * @brief Record the return of an operation, with its result.
+     * @param [in] id The identifier returned by `invoke()`.
+     * @param [in] result The result.
+     */
+    void
+    response (std::size_t id, const Result_T& result)
+    {
+      const std::size_t returned = clock_.fetch_add (1) + 1;
+      if (id == npos)
+        {
+          return;
+        }
+      entries_[id].result = result;
+      entries_[id].returned = returned;
+    }
+
+    /**
+     * @brief Record an operation, executed by a callable.
+     * @param [in] thread The thread index, for the report.
+     * @param [in] operation The operation.
+     * @param [in] callable Invoked without arguments, it executes
+     * the operation and returns its result.
+     * @return The result.
+     */
+    template <class Callable_T>
+    Result_T
+    record (std::size_t thread, const Operation_T& operation,
+            Callable_T&& callable)
+    {
+      const std::size_t id = invoke (thread, operation);
+      const Result_T result = callable ();
+      response (id, result);
+      return result;
+    }
+
+    /**
+     * @brief Forget all operations, to record a new history.
+     */
+    void
+    clear (void)
+    {
+      size_.store (0);
+      dropped_.store (0);
+      clock_.store (0);
+    }
+
+    /**
+     * @brief The number of operations recorded.
+     */
+    [[nodiscard]] std::size_t
+    size (void) const
+    {
+      const std::size_t size = size_.load ();
+      return size < entries_.size () ? size : entries_.size ();
+    }
+
+    /**
+     * @brief The number of operations not recorded, because
+     * the history was full.
+     */
+    [[nodiscard]] std::size_t
+    dropped (void) const
+    {
+      return dropped_.load ();
+    }
+
+    [[nodiscard]] const entry&
+    operator[] (std::size_t index) const
+    {
+      return entries_[index];
+    }
+
+  protected:
+    std::vector<entry> entries_;
+    std::atomic<std::size_t> size_{ 0 };
+    std::atomic<std::size_t> dropped_{ 0 };
+    std::atomic<std::size_t> clock_{ 0 };
+  };
+
+  namespace detail
+  {
+    /**
+     * @brief The sequential model, as seen by the checker, which
+     * knows only the indices of the operations and the depth of the
+     * states (the number of operations ordered).
+     */
+    class linearizability_model
+    {
+    public:
+      linearizability_model () = default;
+
+      linearizability_model (const linearizability_model&) = delete;
+      linearizability_model (linearizability_model&&) = delete;
+      linearizability_model&
+      operator= (const linearizability_model&)
+          = delete;
+      linearizability_model&
+      operator= (linearizability_model&&)
+          = delete;
+
+      virtual ~linearizability_model () = default;
+
+      /**
+       * @brief Apply an operation to the state at `depth`, giving the
+       * state at `depth + 1`.
+       * @return True if the result matches the recorded one.
+       */
+      virtual bool
+      apply (std::size_t depth, std::size_t operation)
+          = 0;
+
+      /**
+       * @brief Remember the state at `depth`, reached after the given
+       * set of operations.
+       * @return False if the pair was already seen.
+       */
+      virtual bool
+      remember (std::size_t depth, const std::vector<std::uint64_t>& set)
+          = 0;
+    };
+
+    struct linearizability_result
+    {
+      bool linearizable;
+      bool gave_up;
+      std::size_t states;
+      std::size_t longest;
+      // The operation which could not be ordered, or the size
+      // of the history.
+      std::size_t stuck;
+    };
+
+    /**
+     * @brief The Wing & Gong search, with the memoisation of Lowe.
+     * @param [in] times The invocation and the return times of each
+     * operation, 0 if it did not return.
+     * @param [in] operations The number of operations.
+     * @param [in] model The sequential model.
+     * @param [in] max_states The maximum number of states to explore.
+     */
+    linearizability_result
+    check_linearizability (const std::size_t* times, std::size_t operations,
+                           linearizability_model& model,
+                           std::size_t max_states);
+
+    template <class Model_T, class Operation_T, class Result_T>
+    class history_model : public linearizability_model
+    {
+    public:
+      history_model (const history<Operation_T, Result_T>& history,
+                     const Model_T& initial)
+          : history_{ history }
+      {
+        states_.push_back (initial);
+      }
+
+      virtual bool
+      apply (std::size_t depth, std::size_t operation) override
+      {
+        if (states_.size () < depth + 2)
+          {
+            states_.push_back (states_[depth]);
+          }
+        else
+          {
+            states_[depth + 1] = states_[depth];
+          }
+        const auto& e = history_[operation];
+        const auto result = states_[depth + 1].apply (e.operation);
+        // Operations that did not return may have any result.
+        return e.returned == 0 || result == e.result;
+      }
+
+      virtual bool
+      remember (std::size_t depth,
+                const std::vector<std::uint64_t>& set) override
+      {
+        const Model_T& state = states_[depth];
+
+        // FNV-1a of the set, combined with the hash of the
+        // state, if the model has one.
+        std::size_t hash = static_cast<std::size_t> (14695981039346656037ull);
+        for (const auto word : set)
+          {
+            hash = (hash ^ static_cast<std::size_t> (word))
+                   * static_cast<std::size_t> (1099511628211ull);
+          }
+        if constexpr (requires { std::hash<Model_T>{}(state); })
+          {
+            hash ^= std::hash<Model_T>{}(state);
+          }
+
+        auto& bucket = cache_[hash];
+        for (const auto index : bucket)
+          {
+            if (seen_[index].first == set && seen_[index].second == state)
+              {
+                return false;
+              }
+          }
+        bucket.push_back (seen_.size ());
+        seen_.emplace_back (set, state);
+        return true;
+      }
+
+    protected:
+      const history<Operation_T, Result_T>& history_;
+      // The states along the current sequence.
+      std::vector<Model_T> states_;
+      std::vector<std::pair<std::vector<std::uint64_t>, Model_T>> seen_;
+      std::unordered_map<std::size_t, std::vector<std::size_t>> cache_;
+    };
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+
+  /**
+   * @ingroup micro-test-plus-function-comparators
+   * @brief Check if a history is linearizable, i.e. if there is
+   * a sequential order of the operations, consistent with the order
+   * of the operations that did not overlap, in which a sequential
+   * model returns the same results.
+   * @tparam Model_T The type of the sequential model, a class with
+   * a member `Result_T apply (const Operation_T&)`, copyable and
+   * comparable with `==`.
+   * @param [in] history The history, after all threads are joined.
+   * @param [in] initial The initial state of the model.
+   * @param [in] max_states The maximum number of states to explore;
+   * the search is exponential in the worst case.
+   * @return An operation to be checked with expect() or assume().
+   *
+   * @details
+   * The check is the search of Wing & Gong, which tries to order
+   * the operations one at a time, backtracking when the result does
+   * not match, with the memoisation of Lowe, which avoids exploring
+   * again a state of the model reached with the same set of operations.
+   * Specialising `std::hash` for the model speeds up the search.
+   *
+   * The operations that did not return may be ordered anywhere after
+   * they were invoked, with any result, or not at all.
+   *
+   * For failures, the first operation that could not be ordered
+   * after the longest valid sequence is displayed.
+   *
+   * @par Example
+   *
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   *
+   * struct queue_model
+   * {
+   *   std::deque<int> values;
+   *
+   *   int
+   *   apply (const queue_operation& op)
+   *   {
+   *     // ...
+   *   }
+   *
+   *   bool
+   *   operator== (const queue_model&) const = default;
+   * };
+   *
+   * mt::history<queue_operation, int> history{ 1000 };
+   * // ... record the operations from several threads ...
+   * mt::expect (mt::linearizable (history, queue_model{}));
+   * ```
+   */
+  template <class Model_T, class Operation_T, class Result_T>
+  [[nodiscard]] detail::linearizable_
+  linearizable (const history<Operation_T, Result_T>& history,
+                const Model_T& initial = {},
+                std::size_t max_states = 1000000)
+  {
+    using entry_t = typename micro_test_plus::history<Operation_T,
+                                                      Result_T>::entry;
+
+    const std::size_t operations = history.size ();
+    std::vector<std::size_t> times;
+    times.reserve (2 * operations);
+    std::size_t pending = 0;
+    for (std::size_t i = 0; i < operations; ++i)
+      {
+        const entry_t& e = history[i];
+        times.push_back (e.invoked);
+        times.push_back (e.returned);
+        pending += (e.returned == 0) ? 1 : 0;
+      }
+
+    detail::history_model<Model_T, Operation_T, Result_T> model{ history,
+                                                                 initial };
+    const detail::linearizability_result result
+        = detail::check_linearizability (times.data (), operations, model,
+                                         max_states);
+
+    const bool value = result.linearizable && history.dropped () == 0;
+    if (result.stuck < operations)
+      {
+        const entry_t& e = history[result.stuck];
+        return detail::linearizable_{
+          {},
+          value,
+          result.gave_up,
+          operations,
+          pending,
+          history.dropped (),
+          result.states,
+          result.longest,
+          e.thread,
+          &e.operation,
+          &detail::print_row<Operation_T>,
+          &e.result,
+          &detail::print_row<Result_T>
+        };
+      }
+    return detail::linearizable_{ {},
+                                  value,
+                                  result.gave_up,
+                                  operations,
+                                  pending,
+                                  history.dropped (),
+                                  result.states,
+                                  result.longest,
+                                  0,
+                                  nullptr,
+                                  nullptr,
+                                  nullptr,
+                                  nullptr };
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_TEST_PLUS_LINEARIZABILITY_H_
+
+// ----------------------------------------------------------------------------
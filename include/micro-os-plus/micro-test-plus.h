@@ -27,6 +27,14 @@
 #include <micro-os-plus/config.h>
 #endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
 
+// Checks issued from other threads than the one running the test
+// cases are accounted only when MICRO_TEST_PLUS_THREAD_SAFE is defined,
+// since it adds a thread check to each passed check;
+// MICRO_TEST_PLUS_NO_THREADS disables it, like the watchdog.
+#if defined(MICRO_TEST_PLUS_NO_THREADS)
+#undef MICRO_TEST_PLUS_THREAD_SAFE
+#endif
+
 #include "reflection.h"
 #include "math.h"
 #include "type-traits.h"
@@ -100,6 +108,22 @@ namespace micro_os_plus::micro_test_plus
   void
   test_case (const char* name, Callable_T&& callable, Args_T&&... arguments);
 
+  /**
+   * @ingroup micro-test-plus-test-case
+   * @brief Define and execute a test case for each type in a list.
+   * @tparam List_T A `type_traits::list<...>` with the types.
+   * @tparam Callable_T The type of an object that can be called.
+   * @param [in] name The test case name or description; the name
+   * of each type is appended, in parenthesis.
+   * @param [in] callable A generic callable object with a type
+   * template parameter, usually a lambda like `[]<class T> () { ... }`.
+   * @par Returns
+   *  Nothing.
+   */
+  template <class List_T, typename Callable_T>
+  void
+  test_case (const char* name, Callable_T&& callable);
+
   /**
    * @ingroup micro-test-plus-expectations
    * @brief Evaluate a generic condition and report the results.
@@ -140,7 +164,18 @@ namespace micro_os_plus::micro_test_plus
   expect (const Expr_T& expr, const reflection::source_location& sl
                               = reflection::source_location::current ())
   {
-    return detail::deferred_reporter<Expr_T>{ expr, false, sl };
+#if defined(MICRO_TEST_PLUS_LITE)
+    if constexpr (detail::is_lite_v<Expr_T>)
+      {
+        return detail::deferred_reporter<detail::lite_expression>{
+          detail::make_lite_expression (expr), false, sl
+        };
+      }
+    else
+#endif
+      {
+        return detail::deferred_reporter<Expr_T>{ expr, false, sl };
+      }
   }
 
   /**
@@ -170,8 +205,65 @@ namespace micro_os_plus::micro_test_plus
   assume (const Expr_T& expr, const reflection::source_location& sl
                               = reflection::source_location::current ())
   {
-    return detail::deferred_reporter<Expr_T>{ expr, true, sl };
+#if defined(MICRO_TEST_PLUS_LITE)
+    if constexpr (detail::is_lite_v<Expr_T>)
+      {
+        return detail::deferred_reporter<detail::lite_expression>{
+          detail::make_lite_expression (expr), true, sl
+        };
+      }
+    else
+#endif
+      {
+        return detail::deferred_reporter<Expr_T>{ expr, true, sl };
+      }
+  }
+
+#if defined(__cpp_nontype_template_args) \
+    && (__cpp_nontype_template_args >= 201911L)
+  /**
+   * @ingroup micro-test-plus-expectations
+   * @brief Evaluate a constant condition at compile time.
+   * @tparam Expr The constant expression to evaluate.
+   * @par Parameters
+   *	None.
+   * @par Returns
+   *  Nothing.
+   *
+   * @details
+   * The expression is passed as a template argument, thus it must be
+   * a constant expression, for example a comparator with literal
+   * operands (like `eq (42_i, 42_i)`) or with `constexpr` values.
+   *
+   * The comparison is performed by the compiler; if it fails,
+   * the build stops with an error that shows the expression,
+   * including the values of the operands.
+   *
+   * At run time, the only effect is to count one more successful check;
+   * no code is generated for the comparison and nothing is displayed,
+   * not even in verbose mode.
+   *
+   * @par Example
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   * using namespace mt::literals;
+   *
+   * mt::static_expect<mt::eq (table[3], 42_i)> ();
+   * ```
+   */
+  template <auto Expr,
+            type_traits::requires_t<
+                type_traits::is_op_v<decltype (Expr)>
+                or type_traits::is_convertible_v<decltype (Expr), bool>>
+            = 0>
+  void
+  static_expect (void)
+  {
+    static_assert (static_cast<bool> (Expr), "static_expect() failed");
+
+    current_test_suite->increment_successful ();
   }
+#endif
 
   // --------------------------------------------------------------------------
 
@@ -416,6 +508,139 @@ namespace micro_os_plus::micro_test_plus
     return detail::le_{ lhs, rhs };
   }
 
+  /**
+   * @ingroup micro-test-plus-function-comparators
+   * @brief Equality comparator for contiguous containers.
+   * @tparam Lhs_T Type of the left hand side container.
+   * @tparam Rhs_T Type of the right hand side container.
+   * @param [in] lhs Left hand side container.
+   * @param [in] rhs Right hand side container.
+   * @return True if the containers have the same size and
+   * equal elements.
+   *
+   * @details
+   * The containers can be anything with `std::data()` and `std::size()`,
+   * like arrays, `std::array`, `std::vector` or `std::span`.
+   *
+   * Unlike `eq()`, the comparison stops at the first difference,
+   * using vectorised memory compares for integral elements,
+   * and, on failure, only a few elements around the first
+   * difference are displayed, together with its index.
+   *
+   * @par Example
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   *
+   * mt::expect (mt::eq_range (rx_buffer, expected_buffer));
+   * ```
+   */
+  template <class Lhs_T, class Rhs_T>
+  [[nodiscard]] constexpr auto
+  eq_range (const Lhs_T& lhs, const Rhs_T& rhs)
+  {
+    return detail::eq_range_{ std::data (lhs), std::size (lhs),
+                              std::data (rhs), std::size (rhs) };
+  }
+
+  /**
+   * @ingroup micro-test-plus-function-comparators
+   * @brief Equality comparator for raw memory areas.
+   * @param [in] lhs Pointer to the first memory area.
+   * @param [in] rhs Pointer to the second memory area.
+   * @param [in] size The number of bytes to compare.
+   * @return True if all bytes are equal.
+   *
+   * @details
+   * The memory is compared in wide chunks, thus checking large buffers
+   * (like DMA buffers or protocol frames) is much faster than
+   * checking each byte individually.
+   *
+   * On failure, the rows of 16 bytes that differ are displayed
+   * side by side, as a hex dump.
+   *
+   * @par Example
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   *
+   * mt::expect (mt::eq_bytes (rx_buffer, tx_buffer, sizeof (rx_buffer)));
+   * ```
+   */
+  [[nodiscard]] inline auto
+  eq_bytes (const void* lhs, const void* rhs, std::size_t size)
+  {
+    return detail::eq_bytes_{ lhs, rhs, size };
+  }
+
+  /**
+   * @ingroup micro-test-plus-function-comparators
+   * @brief Check if all bytes of a memory area are equal to a pattern.
+   * @param [in] data Pointer to the memory area.
+   * @param [in] size The number of bytes to check.
+   * @param [in] pattern The expected value of all bytes.
+   * @return True if all bytes are equal to the pattern.
+   *
+   * @details
+   * On failure, the rows of 16 bytes that differ from the pattern
+   * are displayed side by side with the expected values, as a hex dump.
+   *
+   * @par Example
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   *
+   * mt::expect (mt::filled_with (guard_area, sizeof (guard_area), 0xAA));
+   * ```
+   */
+  [[nodiscard]] inline auto
+  filled_with (const void* data, std::size_t size, std::uint8_t pattern)
+  {
+    return detail::filled_with_{ data, size, pattern };
+  }
+
+  /**
+   * @ingroup micro-test-plus-function-comparators
+   * @brief Check if two containers of floating point values are close.
+   * @tparam Lhs_T Type of the left hand side container.
+   * @tparam Rhs_T Type of the right hand side container.
+   * @param [in] lhs Left hand side container.
+   * @param [in] rhs Right hand side container.
+   * @param [in] rel_tol The relative tolerance, scaled by the largest
+   * of the two magnitudes.
+   * @param [in] abs_tol The absolute tolerance.
+   * @param [in] max_ulps The maximum distance in units in the last place.
+   * @return True if the containers have the same size and all pairs of
+   * elements are close.
+   *
+   * @details
+   * The containers can be anything with `std::data()` and `std::size()`
+   * and elements of the same `float` or `double` type.
+   *
+   * A pair of elements is close if any of the three tolerances
+   * is met; NaNs are never close.
+   *
+   * The comparison is performed in a single pass, by a loop
+   * that the compiler can vectorise, if the target has vector
+   * compares of integers as wide as the elements. On failure, the number of
+   * elements that are not close is displayed, together with the
+   * index and the values of the worst pair.
+   *
+   * @par Example
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   *
+   * mt::expect (mt::all_close (output_samples, expected_samples, 1e-5));
+   * ```
+   */
+  template <class Lhs_T, class Rhs_T>
+  [[nodiscard]] auto
+  all_close (const Lhs_T& lhs, const Rhs_T& rhs, double rel_tol,
+             double abs_tol = 0, std::uint64_t max_ulps = 0)
+  {
+    return detail::all_close_{ std::data (lhs), std::size (lhs),
+                               std::data (rhs), std::size (rhs),
+                               rel_tol,         abs_tol,
+                               max_ulps };
+  }
+
   /**
    * @ingroup micro-test-plus-logical-functions
    * @brief Generic logical **not**.
@@ -721,6 +946,14 @@ namespace micro_os_plus::micro_test_plus
 // All other inlines.
 #include "inlines.h"
 
+#include "property.h"
+#include "table.h"
+#include "combinations.h"
+#include "stress.h"
+#include "interleavings.h"
+#include "linearizability.h"
+#include "mock.h"
+
 // ----------------------------------------------------------------------------
 
 #endif // MICRO_TEST_PLUS_MICRO_TEST_PLUS_H_
@@ -0,0 +1,652 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+#ifndef MICRO_TEST_PLUS_MOCK_H_
+#define MICRO_TEST_PLUS_MOCK_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <cstddef>
+#include <new>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
+#if !defined(__clang__) // GCC only
+#pragma GCC diagnostic ignored "-Wsuggest-final-types"
+#pragma GCC diagnostic ignored "-Wsuggest-final-methods"
+#endif
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wc++98-c++11-c++14-c++17-compat-pedantic"
+#endif
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  /**
+   * @brief Mock objects, which record their calls in a fixed size
+   * log, to be checked with expect() or assume().
+   *
+   * @details
+   * No dynamic memory, exceptions or RTTI are used, thus mocks can
+   * be used on embedded platforms too.
+   */
+  namespace mock
+  {
+    /**
+     * @brief The header of a recorded call; the arguments follow.
+     */
+    struct call_record
+    {
+      const method_base* method;
+      call_record* next;
+      std::size_t sequence;
+    };
+
+    /**
+     * @brief The log of the calls to a group of mock methods,
+     * in an arena provided by the derived class.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     */
+    class call_log_base
+    {
+    public:
+      /**
+       * @brief Construct a call log.
+       * @param [in] arena The memory where the calls are stored.
+       * @param [in] size The size of the arena, in bytes.
+       */
+      call_log_base (std::byte* arena, std::size_t size);
+
+      // The rule of five.
+      call_log_base (const call_log_base&) = delete;
+      call_log_base (call_log_base&&) = delete;
+      call_log_base&
+      operator= (const call_log_base&)
+          = delete;
+      call_log_base&
+      operator= (call_log_base&&)
+          = delete;
+
+      ~call_log_base () = default;
+
+      /**
+       * @brief Append a call to the log.
+       * @param [in] method The method called.
+       * @param [in] size The size of the arguments.
+       * @param [in] alignment The alignment of the arguments.
+       * @return Where to store the arguments, or `nullptr` if the
+       * arena is full.
+       */
+      void*
+      record (const method_base& method, std::size_t size,
+              std::size_t alignment);
+
+      /**
+       * @brief The arguments of a recorded call.
+       */
+      static const void*
+      arguments (const call_record& record, std::size_t alignment);
+
+      /**
+       * @brief Forget all calls, and clear the counters of the methods.
+       */
+      void
+      clear (void);
+
+      [[nodiscard]] constexpr const call_record*
+      first (void) const
+      {
+        return first_;
+      }
+
+      /**
+       * @brief The number of calls recorded.
+       */
+      [[nodiscard]] constexpr std::size_t
+      calls (void) const
+      {
+        return calls_;
+      }
+
+      /**
+       * @brief The number of calls not recorded, because the arena
+       * was full.
+       */
+      [[nodiscard]] constexpr std::size_t
+      dropped (void) const
+      {
+        return dropped_;
+      }
+
+      /**
+       * @brief The number of bytes used in the arena.
+       */
+      [[nodiscard]] constexpr std::size_t
+      used (void) const
+      {
+        return used_;
+      }
+
+    protected:
+      friend class method_base;
+
+      std::byte* arena_;
+      std::size_t size_;
+      std::size_t used_ = 0;
+      std::size_t calls_ = 0;
+      std::size_t dropped_ = 0;
+      call_record* first_ = nullptr;
+      call_record* last_ = nullptr;
+      method_base* methods_ = nullptr;
+    };
+
+    /**
+     * @brief A call log, with an arena of the given size.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     * @tparam Size_V The size of the arena, in bytes; each call takes
+     * a header of three words, followed by the arguments.
+     */
+    template <std::size_t Size_V>
+    class call_log : public call_log_base
+    {
+    public:
+      call_log () : call_log_base{ arena_, Size_V }
+      {
+      }
+
+    protected:
+      alignas (std::max_align_t) std::byte arena_[Size_V];
+    };
+
+    /**
+     * @brief The base class of the mock methods, with the
+     * properties that do not depend on the signature.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     */
+    class method_base
+    {
+    public:
+      /**
+       * @brief Construct a mock method.
+       * @param [in] log The log of the calls, which must exist
+       * as long as the method.
+       * @param [in] name The name, used in reports.
+       */
+      method_base (call_log_base& log, const char* name);
+
+      // The rule of five.
+      method_base (const method_base&) = delete;
+      method_base (method_base&&) = delete;
+      method_base&
+      operator= (const method_base&)
+          = delete;
+      method_base&
+      operator= (method_base&&)
+          = delete;
+
+      virtual ~method_base () = default;
+
+      [[nodiscard]] constexpr const char*
+      name (void) const
+      {
+        return name_;
+      }
+
+      /**
+       * @brief The number of calls, including those not recorded.
+       */
+      [[nodiscard]] constexpr std::size_t
+      calls (void) const
+      {
+        return calls_;
+      }
+
+      [[nodiscard]] constexpr const call_log_base&
+      log (void) const
+      {
+        return log_;
+      }
+
+      /**
+       * @brief Display the arguments of a call, like `(1, 2)`.
+       */
+      virtual void
+      print_arguments (test_reporter& reporter,
+                       const call_record& record) const
+          = 0;
+
+      /**
+       * @brief Display the recorded calls, like `write (1, 2), write (3, 4)`.
+       * @param [in] reporter The reporter.
+       * @param [in] max The maximum number of calls displayed.
+       */
+      void
+      print_calls (test_reporter& reporter, std::size_t max) const;
+
+    protected:
+      friend class call_log_base;
+
+      call_log_base& log_;
+      const char* name_;
+      std::size_t calls_ = 0;
+      method_base* next_ = nullptr;
+    };
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief The type of the matcher of any argument.
+     */
+    struct any_argument
+    {
+    };
+
+    /**
+     * @brief A matcher for any value of an argument.
+     */
+    inline constexpr any_argument _{};
+
+    /**
+     * @brief Check an argument with a matcher, which can be `_`,
+     * a predicate, or a value compared with `==`.
+     */
+    template <class Matcher_T, class Argument_T>
+    [[nodiscard]] constexpr bool
+    matches (const Matcher_T& matcher, const Argument_T& argument)
+    {
+      if constexpr (std::is_same_v<Matcher_T, any_argument>)
+        {
+          return true;
+        }
+      else if constexpr (std::is_invocable_r_v<bool, const Matcher_T&,
+                                               const Argument_T&>)
+        {
+          return matcher (argument);
+        }
+      else
+        {
+          return argument == matcher;
+        }
+    }
+
+    template <class Signature_T>
+    class method;
+
+    /**
+     * @brief A mock method, which records its arguments and returns
+     * a preset value, or the value returned by a function.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     * @tparam Return_T The return type.
+     * @tparam Args_T The types of the arguments; they are recorded by
+     * value, thus they must be trivially destructible (pointers,
+     * not strings).
+     *
+     * @par Example
+     *
+     * ```cpp
+     * namespace mt = micro_os_plus::micro_test_plus;
+     *
+     * class i2c_mock : public i2c_interface
+     * {
+     * public:
+     *   mt::mock::call_log<512> log;
+     *   mt::mock::method<int (std::uint8_t, std::size_t)> write_{ log,
+     *                                                             "write" };
+     *
+     *   int
+     *   write (std::uint8_t address, std::size_t size) override
+     *   {
+     *     return write_ (address, size);
+     *   }
+     * };
+     * ```
+     */
+    template <class Return_T, class... Args_T>
+    class method<Return_T (Args_T...)> : public method_base
+    {
+      static_assert (
+          (std::is_trivially_destructible_v<std::decay_t<Args_T>> && ...),
+          "mock arguments are recorded by value, and must be trivially "
+          "destructible");
+      static_assert (not std::is_reference_v<Return_T>,
+                     "mock methods cannot return references");
+
+    public:
+      using arguments_t = std::tuple<std::decay_t<Args_T>...>;
+      using function_t = Return_T (*) (Args_T...);
+
+      method (call_log_base& log, const char* name) : method_base{ log, name }
+      {
+      }
+
+      /**
+       * @brief Record a call and return the preset value.
+       */
+      Return_T
+      operator() (Args_T... arguments)
+      {
+        ++calls_;
+        void* storage
+            = log_.record (*this, sizeof (arguments_t), alignof (arguments_t));
+        if (storage != nullptr)
+          {
+            new (storage) arguments_t{ arguments... };
+          }
+
+        if (function_ != nullptr)
+          {
+            return function_ (std::forward<Args_T> (arguments)...);
+          }
+        if constexpr (not std::is_void_v<Return_T>)
+          {
+            return result_;
+          }
+      }
+
+      /**
+       * @brief Set the value returned by the next calls.
+       */
+      template <class T = Return_T>
+        requires (not std::is_void_v<T>)
+      void
+      will_return (const T& value)
+      {
+        result_ = value;
+        function_ = nullptr;
+      }
+
+      /**
+       * @brief Set a function invoked by the next calls, usually
+       * a lambda without captures.
+       */
+      void
+      will_invoke (function_t function)
+      {
+        function_ = function;
+      }
+
+      /**
+       * @brief The first recorded call starting with `from`, with
+       * arguments that match, or `nullptr`.
+       * @param [in] from The first call to check.
+       * @param [in] matchers None, for any call, or one for each
+       * argument.
+       */
+      template <class... Matchers_T>
+      [[nodiscard]] const call_record*
+      find (const call_record* from, const Matchers_T&... matchers) const
+      {
+        static_assert (sizeof...(Matchers_T) == 0
+                           || sizeof...(Matchers_T) == sizeof...(Args_T),
+                       "there must be one matcher for each argument");
+
+        for (const call_record* record = from; record != nullptr;
+             record = record->next)
+          {
+            if (record->method != this)
+              {
+                continue;
+              }
+            if constexpr (sizeof...(Matchers_T) == 0)
+              {
+                return record;
+              }
+            else
+              {
+                const arguments_t& recorded = arguments (*record);
+                if (std::apply (
+                        [&] (const auto&... argument) {
+                          return (matches (matchers, argument) && ...);
+                        },
+                        recorded))
+                  {
+                    return record;
+                  }
+              }
+          }
+        return nullptr;
+      }
+
+      /**
+       * @brief The number of recorded calls with arguments that match.
+       */
+      template <class... Matchers_T>
+      [[nodiscard]] std::size_t
+      count (const Matchers_T&... matchers) const
+      {
+        std::size_t count = 0;
+        for (const call_record* record = find (log_.first (), matchers...);
+             record != nullptr; record = find (record->next, matchers...))
+          {
+            ++count;
+          }
+        return count;
+      }
+
+      /**
+       * @brief The arguments of a call of this method.
+       */
+      [[nodiscard]] static const arguments_t&
+      arguments (const call_record& record)
+      {
+        return *std::launder (static_cast<const arguments_t*> (
+            call_log_base::arguments (record, alignof (arguments_t))));
+      }
+
+      virtual void
+      print_arguments (test_reporter& reporter,
+                       const call_record& record) const override
+      {
+        std::apply (
+            [&reporter] (const auto&... argument) {
+              std::size_t i = 0;
+              reporter << '(';
+              ((reporter << (i++ == 0 ? "" : ", "),
+                print_argument (reporter, argument)),
+               ...);
+              reporter << ')';
+            },
+            arguments (record));
+      }
+
+    protected:
+      template <class T>
+      static void
+      print_argument (test_reporter& reporter, const T& value)
+      {
+        if constexpr (std::is_pointer_v<T>)
+          {
+            // The pointed data may no longer exist.
+            reporter << static_cast<const void*> (value);
+          }
+        else if constexpr (std::is_arithmetic_v<T>
+                           || std::is_convertible_v<const T&,
+                                                    std::string_view>)
+          {
+            detail::print_value (reporter, value);
+          }
+        else
+          {
+            detail::print_row<T> (reporter, &value);
+          }
+      }
+
+      struct no_result
+      {
+      };
+
+      std::conditional_t<std::is_void_v<Return_T>, no_result, Return_T>
+          result_{};
+      function_t function_ = nullptr;
+    };
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief An expected call, for in_order().
+     */
+    template <class Method_T, class... Matchers_T>
+    struct call_expectation
+    {
+      const Method_T& method;
+      std::tuple<Matchers_T...> matchers;
+    };
+
+    /**
+     * @ingroup micro-test-plus-function-comparators
+     * @brief An expected call of a method, with arguments that match,
+     * to be passed to in_order().
+     */
+    template <class Method_T, class... Matchers_T>
+    [[nodiscard]] constexpr call_expectation<Method_T, Matchers_T...>
+    call (const Method_T& method, const Matchers_T&... matchers)
+    {
+      return { method, { matchers... } };
+    }
+
+    /**
+     * @ingroup micro-test-plus-function-comparators
+     * @brief Check the number of calls of a method.
+     * @param [in] method The mock method.
+     * @param [in] times The expected number of calls.
+     * @param [in] matchers None, to count all calls, or one for each
+     * argument: `_`, a predicate, or a value.
+     * @return An operation to be checked with expect() or assume().
+     *
+     * @details
+     * Without matchers, all calls are counted, even if the log is
+     * full; with matchers, only the recorded calls can be checked,
+     * thus the expectation fails if some calls were not recorded.
+     *
+     * @par Example
+     *
+     * ```cpp
+     * mt::expect (mt::mock::called (i2c.write_, 1, 0x50, mt::mock::_));
+     * ```
+     */
+    template <class Method_T, class... Matchers_T>
+    [[nodiscard]] detail::mock_called_
+    called (const Method_T& method, std::size_t times,
+            const Matchers_T&... matchers)
+    {
+      if constexpr (sizeof...(Matchers_T) == 0)
+        {
+          return detail::mock_called_{
+            {}, method.calls () == times, &method, times, method.calls (),
+            false, 0
+          };
+        }
+      else
+        {
+          const std::size_t actual = method.count (matchers...);
+          const std::size_t dropped = method.log ().dropped ();
+          return detail::mock_called_{ {},
+                                       actual == times && dropped == 0,
+                                       &method,
+                                       times,
+                                       actual,
+                                       true,
+                                       dropped };
+        }
+    }
+
+    /**
+     * @ingroup micro-test-plus-function-comparators
+     * @brief Check that some calls were made in the given order;
+     * other calls may be made in between.
+     * @param [in] calls The expected calls, created with call().
+     * @return An operation to be checked with expect() or assume().
+     *
+     * @par Example
+     *
+     * ```cpp
+     * mt::expect (mt::mock::in_order (mt::mock::call (spi.select_, true),
+     *                                 mt::mock::call (spi.transfer_),
+     *                                 mt::mock::call (spi.select_, false)));
+     * ```
+     */
+    template <class... Calls_T>
+    [[nodiscard]] detail::mock_in_order_
+    in_order (const Calls_T&... calls)
+    {
+      static_assert (sizeof...(Calls_T) > 0, "at least one call is needed");
+
+      const call_log_base& log
+          = std::get<0> (std::forward_as_tuple (calls...)).method.log ();
+      const call_record* from = log.first ();
+      std::size_t index = 0;
+      std::size_t missing = sizeof...(Calls_T);
+      const method_base* missing_method = nullptr;
+
+      const auto next = [&] (const auto& expected) {
+        if (missing == sizeof...(Calls_T))
+          {
+            const call_record* record = std::apply (
+                [&] (const auto&... matchers) {
+                  return expected.method.find (from, matchers...);
+                },
+                expected.matchers);
+            if (record == nullptr)
+              {
+                missing = index;
+                missing_method = &expected.method;
+              }
+            else
+              {
+                from = record->next;
+              }
+          }
+        ++index;
+      };
+      (next (calls), ...);
+
+      const bool found = (missing == sizeof...(Calls_T));
+      return detail::mock_in_order_{ {},
+                                     found,
+                                     sizeof...(Calls_T),
+                                     missing,
+                                     missing_method,
+                                     found ? 0 : log.dropped () };
+    }
+  } // namespace mock
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_TEST_PLUS_MOCK_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,684 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+#ifndef MICRO_TEST_PLUS_PROPERTY_H_
+#define MICRO_TEST_PLUS_PROPERTY_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wc++98-c++11-c++14-c++17-compat-pedantic"
+#endif
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  /**
+   * @brief Options to configure how a property is checked.
+   * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+   *
+   * @details
+   * If both `iterations` and `time_budget_ms` are set, the first
+   * limit reached ends the run. The time budget is available only
+   * on hosted platforms; on bare-metal it is ignored.
+   */
+  struct property_options
+  {
+    /**
+     * @brief The number of random test cases to try.
+     */
+    std::size_t iterations = 100;
+
+    /**
+     * @brief The maximum duration of the run, in milliseconds,
+     * 0 for no limit.
+     */
+    std::uint32_t time_budget_ms = 0;
+
+    /**
+     * @brief The maximum number of shrinking steps.
+     */
+    std::size_t max_shrinks = 500;
+
+    /**
+     * @brief The seed of the random generator; 0 to use the one
+     * given with `--seed=N`, or a hash of the property name.
+     */
+    std::uint64_t seed = 0;
+  };
+
+  namespace detail
+  {
+    /**
+     * @brief The xoshiro128** pseudo-random generator.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     *
+     * @details
+     * A small, fast and good quality generator, with 32-bit
+     * operations only, thus efficient on microcontrollers too.
+     * The state is initialised from a 64-bit seed with splitmix64.
+     *
+     * See <https://prng.di.unimi.it>.
+     */
+    class xoshiro128
+    {
+    public:
+      explicit xoshiro128 (std::uint64_t seed);
+
+      std::uint32_t
+      next (void);
+
+      std::uint64_t
+      next64 (void);
+
+      /**
+       * @brief One step of the splitmix64 generator, also used
+       * to derive independent seeds.
+       */
+      static std::uint64_t
+      splitmix64 (std::uint64_t& state);
+
+    protected:
+      std::uint32_t state_[4];
+    };
+
+    class property_runner;
+  } // namespace detail
+
+  /**
+   * @brief Composable generators of random values for property().
+   *
+   * @details
+   * A generator is any callable that receives a `generators::source&`
+   * and returns a value. All random decisions must be taken with
+   * `source.draw()`; the choices are recorded, such that a failing
+   * test case can be replayed and shrunk, by trying simpler choices
+   * (smaller values, fewer elements), without generator specific code.
+   *
+   * Choices equal to zero must produce the simplest values.
+   */
+  namespace generators
+  {
+    /**
+     * @brief The source of all random choices made by generators.
+     * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     */
+    class source
+    {
+    public:
+      /**
+       * @brief Random mode; the choices are taken from the
+       * pseudo-random generator and recorded.
+       */
+      explicit source (std::uint64_t seed);
+
+      /**
+       * @brief Replay mode; the choices are taken from the buffer.
+       */
+      source (const std::uint64_t* choices, std::size_t size);
+
+      /**
+       * @brief Make a choice between 0 and `max` inclusive.
+       */
+      std::uint64_t
+      draw (std::uint64_t max);
+
+      /**
+       * @brief An integer between `min` and `max` inclusive, simplest
+       * near 0 (or near the bound closest to 0).
+       */
+      std::int64_t
+      draw_integer (std::int64_t min, std::int64_t max);
+
+      /**
+       * @brief An unsigned integer between `min` and `max` inclusive,
+       * simplest near `min`.
+       */
+      std::uint64_t
+      draw_unsigned (std::uint64_t min, std::uint64_t max);
+
+      /**
+       * @brief A floating point number between `min` and `max`,
+       * simplest near 0; the bounds are drawn more often.
+       */
+      double
+      draw_floating (double min, double max);
+
+      /**
+       * @brief True if more choices were needed than available;
+       * such test cases are discarded.
+       */
+      [[nodiscard]] bool
+      overrun (void) const
+      {
+        return overrun_;
+      }
+
+      /**
+       * @brief The maximum number of choices for a test case.
+       */
+      static constexpr std::size_t max_choices = 8192;
+
+    protected:
+      friend class detail::property_runner;
+
+      detail::xoshiro128 prng_;
+      std::vector<std::uint64_t> choices_;
+      const std::uint64_t* replay_ = nullptr;
+      std::size_t replay_size_ = 0;
+      std::size_t index_ = 0;
+      bool overrun_ = false;
+    };
+
+    /**
+     * @brief The type of the values produced by a generator.
+     */
+    template <class Generator_T>
+    using value_t = std::remove_cv_t<std::remove_reference_t<
+        std::invoke_result_t<const Generator_T&, source&>>>;
+
+    /**
+     * @brief Integers between `min` and `max` inclusive; small
+     * magnitudes are more likely.
+     */
+    template <class T>
+    [[nodiscard]] auto
+    integer (T min = std::numeric_limits<T>::min (),
+             T max = std::numeric_limits<T>::max ())
+    {
+      static_assert (std::is_integral_v<T> and not std::is_same_v<T, bool>);
+      return [min, max] (source& src) -> T {
+        if constexpr (std::is_signed_v<T>)
+          {
+            return static_cast<T> (src.draw_integer (min, max));
+          }
+        else
+          {
+            return static_cast<T> (src.draw_unsigned (min, max));
+          }
+      };
+    }
+
+    /**
+     * @brief Floating point numbers between `min` and `max`; integers,
+     * zero and the bounds are more likely.
+     */
+    template <class T>
+    [[nodiscard]] auto
+    floating (T min = std::numeric_limits<T>::lowest (),
+              T max = std::numeric_limits<T>::max ())
+    {
+      static_assert (std::is_floating_point_v<T>);
+      return [min, max] (source& src) -> T {
+        return static_cast<T> (src.draw_floating (
+            static_cast<double> (min), static_cast<double> (max)));
+      };
+    }
+
+    /**
+     * @brief `true` or `false`, shrinking to `false`.
+     */
+    [[nodiscard]] inline auto
+    boolean (void)
+    {
+      return [] (source& src) -> bool { return src.draw (1) != 0; };
+    }
+
+    /**
+     * @brief The default alphabet, most simple characters first.
+     */
+    inline constexpr std::string_view printable
+        = "abcdefghijklmnopqrstuvwxyz"
+          "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+          "0123456789 !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+
+    /**
+     * @brief Characters from the alphabet, shrinking to the first one.
+     * @param [in] alphabet A non-empty string, which must outlive the
+     * generator (usually a literal).
+     */
+    [[nodiscard]] inline auto
+    character (std::string_view alphabet = printable)
+    {
+      return [alphabet] (source& src) -> char {
+        return alphabet[detail::integer_cast<std::size_t> (
+            src.draw (alphabet.size () - 1))];
+      };
+    }
+
+    /**
+     * @brief Vectors of values from the given generator, with
+     * `min_size` to `max_size` elements.
+     *
+     * @details
+     * Before each optional element there is a choice to continue,
+     * thus the elements can be removed while shrinking.
+     */
+    template <class Generator_T>
+    [[nodiscard]] auto
+    vector_of (Generator_T generator, std::size_t min_size,
+               std::size_t max_size)
+    {
+      return [generator, min_size, max_size] (source& src) {
+        std::vector<value_t<Generator_T>> result;
+        while (result.size () < max_size)
+          {
+            // Continue with probability 7/8; 0 means stop.
+            if (result.size () >= min_size and src.draw (7) == 0)
+              {
+                break;
+              }
+            result.push_back (generator (src));
+          }
+        return result;
+      };
+    }
+
+    /**
+     * @brief Vectors of values from the given generator, with
+     * at most `max_size` elements.
+     */
+    template <class Generator_T>
+    [[nodiscard]] auto
+    vector_of (Generator_T generator, std::size_t max_size = 16)
+    {
+      return vector_of (std::move (generator), 0, max_size);
+    }
+
+    /**
+     * @brief Strings of characters from the alphabet, with at most
+     * `max_size` characters, shrinking to shorter strings.
+     */
+    [[nodiscard]] inline auto
+    string (std::size_t max_size = 16, std::string_view alphabet = printable)
+    {
+      return [max_size, alphabet] (source& src) {
+        std::string result;
+        while (result.size () < max_size and src.draw (7) != 0)
+          {
+            result.push_back (alphabet[detail::integer_cast<std::size_t> (
+                src.draw (alphabet.size () - 1))]);
+          }
+        return result;
+      };
+    }
+
+    /**
+     * @brief One of the given values, shrinking to the first one.
+     */
+    template <class T>
+    [[nodiscard]] auto
+    element_of (std::initializer_list<T> values)
+    {
+      return [values = std::vector<T> (values)] (source& src) -> T {
+        return values[static_cast<std::size_t> (
+            src.draw (values.size () - 1))];
+      };
+    }
+
+    /**
+     * @brief Always the same value.
+     */
+    template <class T>
+    [[nodiscard]] auto
+    constant (T value)
+    {
+      return [value] (source&) -> T { return value; };
+    }
+
+    /**
+     * @brief Transform the values of a generator with a function.
+     */
+    template <class Generator_T, class Function_T>
+    [[nodiscard]] auto
+    map (Generator_T generator, Function_T function)
+    {
+      return [generator, function] (source& src) {
+        return function (generator (src));
+      };
+    }
+  } // namespace generators
+
+  namespace detail
+  {
+    /**
+     * @brief The name of a property, with the location of the call.
+     *
+     * @details
+     * Variadic functions cannot have a defaulted location
+     * after the pack, thus it is captured by the implicit
+     * conversion from the name.
+     */
+    struct property_name
+    {
+      property_name (const char* name,
+                     const reflection::source_location& location
+                     = reflection::source_location::current ())
+          : name_{ name }, location_{ location }
+      {
+      }
+
+      const char* name_;
+      reflection::source_location location_;
+    };
+
+    /**
+     * @brief The outcome of running a property.
+     */
+    struct property_result
+    {
+      bool passed = true;
+      std::size_t tests = 0;
+      std::size_t shrinks = 0;
+      std::uint64_t seed = 0;
+      /**
+       * @brief The choices of the smallest failing test case.
+       */
+      std::vector<std::uint64_t> choices;
+    };
+
+    /**
+     * @brief Run the random test cases and shrink the first failure.
+     *
+     * @details
+     * Not a template, the generators and the predicate are
+     * reached via the `check` function, which returns `false`
+     * if the property fails for the values generated from the
+     * source.
+     */
+    class property_runner
+    {
+    public:
+      using check_function_t = bool (*) (void* context,
+                                         generators::source& source);
+
+      property_runner (const char* name, const property_options& options,
+                       check_function_t check, void* context);
+
+      property_result
+      run (void);
+
+    protected:
+      bool
+      fails_ (generators::source& source);
+
+      bool
+      try_shrink_ (std::vector<std::uint64_t>& candidate);
+
+      void
+      shrink_ (void);
+
+      const char* name_;
+      const property_options& options_;
+      check_function_t check_;
+      void* context_;
+      property_result result_{};
+      std::size_t attempts_ = 0;
+    };
+
+    /**
+     * @brief Holds references to the generators and the predicate.
+     */
+    template <class Predicate_T, class... Generators_T>
+    struct property_context
+    {
+      using values_t = std::tuple<generators::value_t<Generators_T>...>;
+
+      values_t
+      generate (generators::source& source) const
+      {
+        return std::apply (
+            [&source] (const auto&... generator) {
+              // Braced initialisation guarantees the order.
+              return values_t{ generator (source)... };
+            },
+            generators_);
+      }
+
+      static bool
+      check (void* context, generators::source& source)
+      {
+        auto& self = *static_cast<property_context*> (context);
+        const auto values = self.generate (source);
+#if defined(__cpp_exceptions)
+        try
+          {
+#endif
+            return static_cast<bool> (std::apply (self.predicate_, values));
+#if defined(__cpp_exceptions)
+          }
+        catch (...)
+          {
+            return false;
+          }
+#endif
+      }
+
+      std::tuple<const Generators_T&...> generators_;
+      Predicate_T& predicate_;
+    };
+
+    template <class T>
+    void
+    print_value (test_reporter& reporter, const T& value)
+    {
+      if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+          reporter << '"' << std::string_view{ value } << '"';
+        }
+      else if constexpr (std::is_same_v<T, char>)
+        {
+          reporter << '\'' << value << '\'';
+        }
+      else if constexpr (std::is_enum_v<T>)
+        {
+          // Promoted, to display small types as numbers too.
+          reporter << +static_cast<std::underlying_type_t<T>> (value);
+        }
+      else if constexpr (type_traits::is_container_v<T>)
+        {
+          reporter << '{';
+          bool first = true;
+          for (const auto& element : value)
+            {
+              if (not first)
+                {
+                  reporter << ", ";
+                }
+              print_value (reporter, element);
+              first = false;
+            }
+          reporter << '}';
+        }
+      else if constexpr (std::is_arithmetic_v<T> || std::is_pointer_v<T>
+                         || std::is_null_pointer_v<T>
+                         || type_traits::is_op_v<T>)
+        {
+          reporter << value;
+        }
+      else
+        {
+          // The reporter has no operators for other types, like
+          // nested structures.
+          reporter << "{...}";
+        }
+    }
+
+    template <class Tuple_T>
+    void
+    print_property_values (test_reporter& reporter, const void* values)
+    {
+      std::apply (
+          [&reporter] (const auto&... value) {
+            std::size_t i = 0;
+            reporter << '(';
+            ((reporter << (i++ == 0 ? "" : ", "),
+              print_value (reporter, value)),
+             ...);
+            reporter << ')';
+          },
+          *static_cast<const Tuple_T*> (values));
+    }
+
+    template <class Tuple_T, std::size_t First, std::size_t... Is>
+    void
+    check_property (const property_name& name,
+                    const property_options& options, Tuple_T& arguments,
+                    std::index_sequence<Is...>)
+    {
+      constexpr std::size_t last = std::tuple_size_v<Tuple_T> - 1;
+      using context_t = property_context<
+          std::remove_reference_t<std::tuple_element_t<last, Tuple_T>>,
+          std::remove_cv_t<std::remove_reference_t<
+              std::tuple_element_t<First + Is, Tuple_T>>>...>;
+
+      context_t context{ { std::get<First + Is> (arguments)... },
+                         std::get<last> (arguments) };
+
+      test_case (name.name_, [&] {
+        property_runner runner{ name.name_, options, &context_t::check,
+                                &context };
+        const auto result = runner.run ();
+        if (result.passed)
+          {
+            expect (property_{ {},
+                               true,
+                               result.tests,
+                               0,
+                               result.seed,
+                               nullptr,
+                               nullptr },
+                    name.location_);
+          }
+        else
+          {
+            // Regenerate the values of the smallest failing case.
+            generators::source replay{ result.choices.data (),
+                                       result.choices.size () };
+            const auto values = context.generate (replay);
+            expect (property_{
+                        {},
+                        false,
+                        result.tests,
+                        result.shrinks,
+                        result.seed,
+                        &values,
+                        &print_property_values<typename context_t::values_t> },
+                    name.location_);
+          }
+      });
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+
+  /**
+   * @ingroup micro-test-plus-test-case
+   * @brief Check that a predicate holds for random values.
+   * @tparam Args_T The types of the arguments.
+   * @param [in] name The property name, used as the test case name.
+   * @param [in] arguments An optional `property_options`, followed by
+   * one generator for each parameter of the predicate, followed by
+   * the predicate, which returns `true` if the property holds.
+   * @par Returns
+   *  Nothing.
+   *
+   * @details
+   * The predicate is called with values produced by the generators,
+   * for the configured number of iterations or time budget.
+   * If it returns `false` (or throws), the values are shrunk to
+   * a minimal counterexample, which is reported together with the
+   * seed required to reproduce the failure, via `--seed=N`.
+   *
+   * The property is reported as a test case with a single check.
+   *
+   * @par Example
+   *
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   * namespace gen = mt::generators;
+   *
+   * mt::property ("Reverse twice", gen::vector_of (gen::integer<int> ()),
+   *               [] (const std::vector<int>& v) {
+   *                 auto r = v;
+   *                 std::reverse (r.begin (), r.end ());
+   *                 std::reverse (r.begin (), r.end ());
+   *                 return r == v;
+   *               });
+   * ```
+   */
+  template <class... Args_T>
+  void
+  property (detail::property_name name, Args_T&&... arguments)
+  {
+    static_assert (sizeof...(Args_T) >= 1, "the predicate is mandatory");
+    auto tuple = std::forward_as_tuple (std::forward<Args_T> (arguments)...);
+    using tuple_t = decltype (tuple);
+    constexpr std::size_t size = sizeof...(Args_T);
+
+    if constexpr (std::is_same_v<std::remove_cv_t<std::remove_reference_t<
+                                     std::tuple_element_t<0, tuple_t>>>,
+                                 property_options>)
+      {
+        static_assert (size >= 2, "the predicate is mandatory");
+        detail::check_property<tuple_t, 1> (
+            name, std::get<0> (tuple), tuple,
+            std::make_index_sequence<size - 2>{});
+      }
+    else
+      {
+        detail::check_property<tuple_t, 0> (
+            name, property_options{}, tuple,
+            std::make_index_sequence<size - 1>{});
+      }
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_TEST_PLUS_PROPERTY_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,164 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+#ifndef MICRO_TEST_PLUS_STRESS_H_
+#define MICRO_TEST_PLUS_STRESS_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wc++98-c++11-c++14-c++17-compat-pedantic"
+#endif
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  namespace detail
+  {
+    /**
+     * @brief Invoke one iteration of a stress test; false if it failed.
+     */
+    using stress_function_t = bool (*) (void* callable, std::size_t thread,
+                                        std::size_t iteration);
+
+    /**
+     * @brief Run the iterations on the threads and collect the results.
+     */
+    stress_
+    run_stress (std::size_t threads, std::size_t iterations,
+                stress_function_t function, void* callable);
+
+    template <class Callable_T>
+    bool
+    invoke_stress (void* callable, std::size_t thread, std::size_t iteration)
+    {
+      Callable_T& body = *static_cast<Callable_T*> (callable);
+      if constexpr (std::is_invocable_v<Callable_T&, std::size_t,
+                                        std::size_t>)
+        {
+          if constexpr (std::is_void_v<std::invoke_result_t<
+                            Callable_T&, std::size_t, std::size_t>>)
+            {
+              body (thread, iteration);
+              return true;
+            }
+          else
+            {
+              return static_cast<bool> (body (thread, iteration));
+            }
+        }
+      else
+        {
+          if constexpr (std::is_void_v<std::invoke_result_t<Callable_T&>>)
+            {
+              body ();
+              return true;
+            }
+          else
+            {
+              return static_cast<bool> (body ());
+            }
+        }
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+
+  /**
+   * @ingroup micro-test-plus-function-comparators
+   * @brief Run a callable concurrently on several threads, for a number
+   * of iterations each.
+   * @tparam Callable_T The type of the body.
+   * @param [in] threads The number of threads.
+   * @param [in] iterations The number of iterations of each thread.
+   * @param [in] callable The body, invoked as `callable (thread, iteration)`
+   * or `callable ()`, returning a boolean or nothing; the same object
+   * is used by all threads.
+   * @return An operation to be checked with expect() or assume().
+   *
+   * @details
+   * The threads are created in advance and wait behind a spinning
+   * barrier, thus they all start at the same time; if there are
+   * enough processors, each thread is pinned to a different one
+   * (on Linux).
+   *
+   * The result is successful if none of the iterations returned
+   * false and none of the checks issued by the body failed.
+   * It displays the total duration and the throughput of each
+   * thread, in iterations per second.
+   *
+   * Available when `MICRO_TEST_PLUS_THREAD_SAFE` is defined.
+   *
+   * @par Example
+   *
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   *
+   * lock_free_queue<int> queue;
+   * mt::expect (mt::stress (4, 100000, [&] (std::size_t thread,
+   *                                         std::size_t iteration) {
+   *   queue.push (static_cast<int> (iteration));
+   *   return queue.pop ().has_value ();
+   * })) << "push/pop under contention";
+   * ```
+   */
+  template <class Callable_T>
+  [[nodiscard]] detail::stress_
+  stress (std::size_t threads, std::size_t iterations, Callable_T&& callable)
+  {
+    using callable_t
+        = std::remove_const_t<std::remove_reference_t<Callable_T>>;
+
+    return detail::run_stress (
+        threads, iterations, &detail::invoke_stress<callable_t>,
+        const_cast<callable_t*> (std::addressof (callable)));
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_TEST_PLUS_STRESS_H_
+
+// ----------------------------------------------------------------------------
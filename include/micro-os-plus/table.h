@@ -0,0 +1,335 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+#ifndef MICRO_TEST_PLUS_TABLE_H_
+#define MICRO_TEST_PLUS_TABLE_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wc++98-c++11-c++14-c++17-compat-pedantic"
+#endif
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  namespace detail
+  {
+    /**
+     * @brief An object convertible to anything, used to count the
+     * fields of aggregates.
+     */
+    struct any_field
+    {
+      template <class T>
+      constexpr
+      operator T () const noexcept;
+    };
+
+    /**
+     * @brief The number of values an aggregate can be initialised
+     * with, by trying more and more values; with brace elision,
+     * each element of an array member counts as a value.
+     */
+    template <class T, class... Fields_T>
+    constexpr std::size_t
+    count_initializers (void)
+    {
+      if constexpr (sizeof...(Fields_T) > 8)
+        {
+          return sizeof...(Fields_T);
+        }
+      else if constexpr (requires { T{ Fields_T{}..., any_field{} }; })
+        {
+          return count_initializers<T, Fields_T..., any_field> ();
+        }
+      else
+        {
+          return sizeof...(Fields_T);
+        }
+    }
+
+#if defined(__cpp_aggregate_paren_init)
+    /**
+     * @brief The same, but initialising in parentheses, without
+     * brace elision, thus stopping at the first array member.
+     */
+    template <class T, class... Fields_T>
+    constexpr std::size_t
+    count_paren_initializers (void)
+    {
+      if constexpr (sizeof...(Fields_T) > 8)
+        {
+          return sizeof...(Fields_T);
+        }
+      else if constexpr (requires { T (Fields_T{}..., any_field{}); })
+        {
+          return count_paren_initializers<T, Fields_T..., any_field> ();
+        }
+      else
+        {
+          return sizeof...(Fields_T);
+        }
+    }
+#endif
+
+    /**
+     * @brief The number of fields of an aggregate, or 0 if it has
+     * array members, which cannot be counted.
+     */
+    template <class T>
+    constexpr std::size_t
+    count_fields (void)
+    {
+      constexpr std::size_t count = count_initializers<T> ();
+#if defined(__cpp_aggregate_paren_init)
+      // A single value may also initialise a copy of the aggregate.
+      if constexpr (count > 1 && count_paren_initializers<T> () != count)
+        {
+          return 0;
+        }
+#endif
+      return count;
+    }
+
+    template <class T>
+    concept tuple_like = requires { std::tuple_size<T>::value; };
+
+    /**
+     * @brief Display the fields of a row, as `{a, b, c}`.
+     *
+     * @details
+     * Tuples and pairs are displayed with all their elements;
+     * aggregates with up to 8 fields are decomposed with structured
+     * bindings; other types (and aggregates containing arrays,
+     * which cannot be counted) are displayed as `{...}`.
+     * Enumerations are displayed as numbers, and the fields that
+     * cannot be displayed, like nested structures, as `{...}`.
+     */
+    template <class T>
+    void
+    print_row (test_reporter& reporter, const void* object)
+    {
+      const T& row = *static_cast<const T*> (object);
+      const auto print_fields = [&reporter] (const auto&... field) {
+        std::size_t i = 0;
+        reporter << '{';
+        ((reporter << (i++ == 0 ? "" : ", "), print_value (reporter, field)),
+         ...);
+        reporter << '}';
+      };
+
+      if constexpr (tuple_like<T>)
+        {
+          std::apply (print_fields, row);
+        }
+      else if constexpr (std::is_aggregate_v<T>)
+        {
+          constexpr std::size_t fields = count_fields<T> ();
+          if constexpr (fields == 1)
+            {
+              const auto& [a] = row;
+              print_fields (a);
+            }
+          else if constexpr (fields == 2)
+            {
+              const auto& [a, b] = row;
+              print_fields (a, b);
+            }
+          else if constexpr (fields == 3)
+            {
+              const auto& [a, b, c] = row;
+              print_fields (a, b, c);
+            }
+          else if constexpr (fields == 4)
+            {
+              const auto& [a, b, c, d] = row;
+              print_fields (a, b, c, d);
+            }
+          else if constexpr (fields == 5)
+            {
+              const auto& [a, b, c, d, e] = row;
+              print_fields (a, b, c, d, e);
+            }
+          else if constexpr (fields == 6)
+            {
+              const auto& [a, b, c, d, e, f] = row;
+              print_fields (a, b, c, d, e, f);
+            }
+          else if constexpr (fields == 7)
+            {
+              const auto& [a, b, c, d, e, f, g] = row;
+              print_fields (a, b, c, d, e, f, g);
+            }
+          else if constexpr (fields == 8)
+            {
+              const auto& [a, b, c, d, e, f, g, h] = row;
+              print_fields (a, b, c, d, e, f, g, h);
+            }
+          else
+            {
+              reporter << "{...}";
+            }
+        }
+      else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+        {
+          print_value (reporter, row);
+        }
+      else
+        {
+          reporter << "{...}";
+        }
+    }
+
+    template <class T>
+    void
+    print_table_result (test_reporter& reporter, const void* object)
+    {
+      reporter << *static_cast<const T*> (object);
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+
+  /**
+   * @ingroup micro-test-plus-test-case
+   * @brief Define and execute a test case that checks all rows
+   * of a table.
+   * @tparam Rows_T The type of the table, an array or a container.
+   * @tparam Callable_T The type of the body.
+   * @param [in] name The test case name or description.
+   * @param [in] rows The table; preferably a `static constexpr`
+   * array, to be placed in read-only memory.
+   * @param [in] body A callable invoked with each row, returning
+   * a boolean or a comparator, like `eq (f (row.input), row.output)`.
+   * @param [in] sl Optional source location, by default the current line.
+   * @par Returns
+   *  Nothing.
+   *
+   * @details
+   * All rows are checked by a single loop, with a single check
+   * site, thus the code size does not depend on the number of rows.
+   *
+   * If all rows pass, a single successful check is reported;
+   * otherwise each failing row is reported as a failed check,
+   * with its index, its fields and the result of the body.
+   *
+   * @par Example
+   *
+   * ```cpp
+   * namespace mt = micro_os_plus::micro_test_plus;
+   *
+   * struct row
+   * {
+   *   int a;
+   *   int b;
+   *   int sum;
+   * };
+   * static constexpr row rows[] = {
+   *   { 1, 2, 3 },
+   *   { -1, 1, 0 },
+   * };
+   *
+   * mt::table_case ("Sums", rows, [] (const row& r) {
+   *   return mt::eq (add (r.a, r.b), r.sum);
+   * });
+   * ```
+   */
+  template <class Rows_T, class Callable_T>
+  void
+  table_case (const char* name, const Rows_T& rows, Callable_T&& body,
+              const reflection::source_location& sl
+              = reflection::source_location::current ())
+  {
+    using row_t = std::remove_cv_t<
+        std::remove_reference_t<decltype (*std::begin (rows))>>;
+    using result_t = std::remove_cv_t<
+        std::remove_reference_t<std::invoke_result_t<Callable_T&,
+                                                     const row_t&>>>;
+
+    if (not current_test_suite->begin_test_case (name))
+      {
+        return;
+      }
+
+    bool passed = true;
+    std::size_t index = 0;
+    for (const row_t& row : rows)
+      {
+        const result_t result = body (row);
+        if (not static_cast<bool> (result))
+          {
+            passed = false;
+            detail::table_row_::print_function_t print_result = nullptr;
+            if constexpr (type_traits::is_op_v<result_t>)
+              {
+                print_result = &detail::print_table_result<result_t>;
+              }
+            expect (detail::table_row_{ {},
+                                        false,
+                                        index,
+                                        std::size (rows),
+                                        &row,
+                                        &detail::print_row<row_t>,
+                                        &result,
+                                        print_result },
+                    sl);
+          }
+        ++index;
+      }
+
+    if (passed)
+      {
+        expect (detail::table_row_{
+                    {}, true, 0, std::size (rows), nullptr, nullptr, nullptr,
+                    nullptr },
+                sl);
+      }
+
+    current_test_suite->end_test_case ();
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_TEST_PLUS_TABLE_H_
+
+// ----------------------------------------------------------------------------
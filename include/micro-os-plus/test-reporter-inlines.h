@@ -135,6 +135,27 @@ namespace micro_os_plus::micro_test_plus
                   << colors_.none);
   }
 
+  template <class Lhs_T, class Rhs_T>
+  test_reporter&
+  test_reporter::operator<< (const detail::eq_range_<Lhs_T, Rhs_T>& op)
+  {
+    // When successful, show the first elements.
+    const auto index = op ? 0 : op.mismatch ();
+
+    *this << color (op);
+    output_range_window_ (op.lhs (), op.lhs_size (), index, not op);
+    *this << " == ";
+    output_range_window_ (op.rhs (), op.rhs_size (), index, not op);
+    *this << colors_.none;
+
+    if (not op)
+      {
+        output_range_mismatch_ (op.mismatch (), op.lhs_size (),
+                                op.rhs_size ());
+      }
+    return *this;
+  }
+
   template <class Lhs_T, class Rhs_T>
   test_reporter&
   test_reporter::operator<< (const detail::and_<Lhs_T, Rhs_T>& op)
@@ -183,11 +204,60 @@ namespace micro_os_plus::micro_test_plus
   }
 #endif
 
+  template <class T>
+  void
+  test_reporter::output_range_window_ (const T* data, std::size_t size,
+                                       std::size_t index, bool highlight)
+  {
+    constexpr auto window = detail::eq_range_<T, T>::window;
+    const std::size_t first = (index > window) ? index - window : 0;
+    const std::size_t last
+        = (size - index > window) ? index + window + 1 : size;
+
+    *this << '{';
+    if (first > 0)
+      {
+        *this << "..., ";
+      }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+#endif
+    for (std::size_t i = first; i < last; ++i)
+      {
+        if (i > first)
+          {
+            *this << ", ";
+          }
+        if (highlight && i == index)
+          {
+            *this << '[' << data[i] << ']';
+          }
+        else
+          {
+            *this << data[i];
+          }
+      }
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    if (last < size)
+      {
+        *this << ", ...";
+      }
+    *this << '}';
+  }
+
   template <class Expr_T>
   void
   test_reporter::pass (Expr_T& expr, std::string& message)
   {
-    output_pass_prefix_ (message);
+    if (not output_pass_prefix_ (message))
+      {
+        return;
+      }
 
     if (message.empty ())
       {
@@ -211,6 +281,11 @@ namespace micro_os_plus::micro_test_plus
       }
 
     output_fail_suffix_ (abort);
+
+    if constexpr (type_traits::is_op_v<Expr_T>)
+      {
+        output_fail_details_ (expr);
+      }
   }
 
   // --------------------------------------------------------------------------
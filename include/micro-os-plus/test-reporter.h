@@ -26,6 +26,7 @@
 // #include <functional>
 #include <string_view>
 #include <string>
+#include <cstdint>
 
 #include "type-traits.h"
 #include "test-suite.h"
@@ -234,6 +235,80 @@ namespace micro_os_plus::micro_test_plus
     test_reporter&
     operator<< (const detail::le_<Rhs_T, Lhs_T>& op);
 
+    /**
+     * @brief Output operator to display eq_range() expressions.
+     */
+    template <class Lhs_T, class Rhs_T>
+    test_reporter&
+    operator<< (const detail::eq_range_<Lhs_T, Rhs_T>& op);
+
+    /**
+     * @brief Output operator to display eq_bytes() expressions.
+     */
+    test_reporter&
+    operator<< (const detail::eq_bytes_& op);
+
+    /**
+     * @brief Output operator to display filled_with() expressions.
+     */
+    test_reporter&
+    operator<< (const detail::filled_with_& op);
+
+    /**
+     * @brief Output operator to display all_close() expressions.
+     */
+    test_reporter&
+    operator<< (const detail::all_close_& op);
+
+    /**
+     * @brief Output operator to display property() results.
+     */
+    test_reporter&
+    operator<< (const detail::property_& op);
+
+    /**
+     * @brief Output operator to display stress() results.
+     */
+    test_reporter&
+    operator<< (const detail::stress_& op);
+
+    /**
+     * @brief Output operator to display explore() results.
+     */
+    test_reporter&
+    operator<< (const detail::explore_& op);
+
+    /**
+     * @brief Output operator to display linearizable() results.
+     */
+    test_reporter&
+    operator<< (const detail::linearizable_& op);
+
+    /**
+     * @brief Output operator to display mock::called() results.
+     */
+    test_reporter&
+    operator<< (const detail::mock_called_& op);
+
+    /**
+     * @brief Output operator to display mock::in_order() results.
+     */
+    test_reporter&
+    operator<< (const detail::mock_in_order_& op);
+
+    /**
+     * @brief Output operator to display table_case() rows.
+     */
+    test_reporter&
+    operator<< (const detail::table_row_& op);
+
+    /**
+     * @brief Output operator to display the expressions
+     * erased in the lite mode.
+     */
+    test_reporter&
+    operator<< (const detail::lite_expression& expr);
+
     /**
      * @brief Output operator to display and() expressions.
      */
@@ -295,6 +370,14 @@ namespace micro_os_plus::micro_test_plus
     void
     end_test_case (const char* name);
 
+    /**
+     * @brief Display the number of cases and the coverage
+     * of combinations().
+     */
+    void
+    output_coverage (const char* name,
+                     const detail::combinations_coverage& coverage);
+
     void
     begin_test_suite (const char* name);
 
@@ -310,17 +393,45 @@ namespace micro_os_plus::micro_test_plus
     void
     output (void);
 
+    /**
+     * @brief Display the buffered output and the test case that
+     * exceeded the `--timeout=` limit.
+     */
+    void
+    output_timeout (std::uint32_t timeout_ms);
+
     // Used to nicely format the output, without empty lines
     // between successful test cases.
     bool add_empty_line{ true };
 
+    /**
+     * @brief The location of the last successful check, to help
+     * find where a test case that timed out was blocked.
+     */
+    reflection::source_location last_pass{};
+
     verbosity_t verbosity{};
 
+    /**
+     * @brief Check if the passed checks are displayed, in verbose
+     * mode, or in normal mode with the test cases that fail.
+     */
+    [[nodiscard]] constexpr bool
+    displays_passes (void) const
+    {
+      return verbosity == verbosity::verbose
+             || (verbosity == verbosity::normal && is_in_test_case_);
+    }
+
   protected:
     // The prefix/suffix methods help shorten the code
     // generated by the template methods.
 
-    void
+    /**
+     * @brief Start the line of a passed check, if displayed;
+     * otherwise return false, and the check is not formatted.
+     */
+    bool
     output_pass_prefix_ (std::string& message);
 
     void
@@ -333,10 +444,55 @@ namespace micro_os_plus::micro_test_plus
     void
     output_fail_suffix_ (bool abort);
 
+    /**
+     * @brief Display additional lines after a failed check;
+     * by default nothing.
+     */
+    template <class Expr_T>
+    void
+    output_fail_details_ ([[maybe_unused]] const Expr_T& expr)
+    {
+    }
+
+    void
+    output_fail_details_ (const detail::eq_bytes_& op);
+
+    void
+    output_fail_details_ (const detail::filled_with_& op);
+
+    void
+    output_lite_operand_ (const detail::lite_operand& operand);
+
+    void
+    output_hex_dump_ (const std::uint8_t* lhs, const std::uint8_t* rhs,
+                      std::uint8_t pattern, std::size_t size,
+                      std::size_t offset, std::size_t max_rows);
+
+    /**
+     * @brief Display the elements of a range around an index.
+     */
+    template <class T>
+    void
+    output_range_window_ (const T* data, std::size_t size, std::size_t index,
+                          bool highlight);
+
+    void
+    output_range_mismatch_ (std::size_t index, std::size_t lhs_size,
+                            std::size_t rhs_size);
+
     colors colors_{};
     std::string out_{};
 
     bool is_in_test_case_ = false;
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+    // The messages of the other threads are merged into the buffer.
+    friend void
+    detail::mark_runner_check (void);
+
+    friend void
+    detail::merge_worker_checks (test_suite_base& suite);
+#endif
   };
 
   // --------------------------------------------------------------------------
@@ -23,7 +23,10 @@
 
 // ----------------------------------------------------------------------------
 
+#include <cstdint>
 #include <functional>
+#include <string>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 
@@ -40,6 +43,24 @@ namespace micro_os_plus::micro_test_plus
   // --------------------------------------------------------------------------
 
   class test_suite_base;
+  class test_case_descriptor;
+
+  namespace detail
+  {
+    class watchdog;
+
+    /**
+     * @brief The results of a test case executed several times,
+     * with `--repeat=N` or `--until-fail`.
+     */
+    struct test_case_statistics
+    {
+      std::string suite_name;
+      std::string test_case_name;
+      int runs;
+      int failures;
+    };
+  } // namespace detail
 
   // --------------------------------------------------------------------------
 
@@ -85,21 +106,213 @@ namespace micro_os_plus::micro_test_plus
     void
     register_test_suite (test_suite_base* suite);
 
+    /**
+     * @brief Called by registered test case constructors to
+     * add their descriptors to the runner.
+     */
+    void
+    register_test_case (test_case_descriptor* descriptor);
+
     constexpr const char*
     name (void)
     {
       return default_suite_name_;
     }
 
+    /**
+     * @brief The seed passed with `--seed=N`, or 0 if not given.
+     */
+    constexpr std::uint64_t
+    seed (void)
+    {
+      return seed_;
+    }
+
+    /**
+     * @brief Check if a test case must be executed; with
+     * `--rerun-failed`, only those that failed in the previous run.
+     */
+    bool
+    should_run (const char* suite_name, const char* test_case_name);
+
+    /**
+     * @brief Check if a test suite has test cases to execute.
+     */
+    bool
+    should_run (const char* suite_name);
+
+    /**
+     * @brief Called at the end of each test case; a failed test case
+     * is counted and remembered, to be written to the state file.
+     * When repeating, the results of all runs are also collected.
+     */
+    void
+    record_test_case (const char* suite_name, const char* test_case_name,
+                      bool failed);
+
+    /**
+     * @brief Check if the number of failed test cases reached
+     * the limit set with `--max-failures=N` or `--fail-fast`;
+     * if so, no further test cases and test suites are executed.
+     */
+    constexpr bool
+    stopped (void)
+    {
+      return max_failures_ > 0 && failed_test_cases_ >= max_failures_;
+    }
+
+    /**
+     * @brief Start the timer of the current test case, if
+     * `--timeout=` was passed.
+     */
+    void
+    arm_watchdog (void);
+
+    /**
+     * @brief Stop the timer of the current test case.
+     */
+    void
+    disarm_watchdog (void);
+
+    /**
+     * @brief Called when the current test case cannot end normally,
+     * after a failed assumption or a timeout, to record it as failed
+     * and to write the state file before the process terminates.
+     */
+    void
+    record_interrupted_test_case (void);
+
     [[noreturn]] void
     abort (void);
 
   protected:
+    /**
+     * @brief Execute the registered test cases in the default
+     * test suite and all test suites, once.
+     * @return True if all were successful.
+     */
+    bool
+    run_iteration_ (void);
+
+    /**
+     * @brief Display the test cases that failed in some of the
+     * runs, but not in all, in the order of their failure rate.
+     */
+    void
+    output_statistics_ (int iterations);
+
+    /**
+     * @brief Execute the registered test cases of a test suite,
+     * or of the default test suite if `nullptr`.
+     */
+    void
+    run_registered_test_cases_ (test_suite_base* suite);
+
+    /**
+     * @brief Display the registered test cases selected by
+     * `--filter=` and `--tag=`, for `--list`.
+     */
+    void
+    list_test_cases_ (void);
+
+    void
+    read_state_ (void);
+
+    /**
+     * @brief Write the failed test cases to the state file; not when
+     * only some test cases were selected, or when a rerun did not
+     * complete, since the other failures would be forgotten.
+     */
+    void
+    write_state_ (bool completed);
+
     int argc_ = 0;
     char** argv_ = nullptr;
 
     const char* default_suite_name_ = "Test";
 
+    std::uint64_t seed_ = 0;
+
+    /**
+     * @brief The maximum duration of a test case, in milliseconds,
+     * passed with `--timeout=`, in seconds; 0 for no limit.
+     */
+    std::uint32_t timeout_ms_ = 0;
+
+    /**
+     * @brief The watchdog thread, on hosted platforms only.
+     */
+    detail::watchdog* watchdog_ = nullptr;
+
+    /**
+     * @brief The file with the failed test cases; by default
+     * the program name with the `.state` extension, on hosted
+     * platforms only.
+     */
+    std::string state_file_{};
+
+    /**
+     * @brief True if only the test cases in `rerun_` must be executed.
+     */
+    bool rerun_failed_ = false;
+
+    /**
+     * @brief The test cases that failed in the previous run,
+     * as `suite<TAB>test case`.
+     */
+    std::vector<std::string> rerun_{};
+
+    /**
+     * @brief The test cases that failed in this run,
+     * as `suite<TAB>test case`.
+     */
+    std::vector<std::string> failures_{};
+
+    /**
+     * @brief The pattern passed with `--filter=`, matched against
+     * the test case names, with `*` and `?` wildcards.
+     */
+    const char* filter_ = nullptr;
+
+    /**
+     * @brief The tag passed with `--tag=`; only the registered
+     * test cases with this tag are executed.
+     */
+    const char* tag_ = nullptr;
+
+    /**
+     * @brief The number of failed test cases after which the
+     * execution stops; 0 for no limit.
+     */
+    int max_failures_ = 0;
+
+    /**
+     * @brief The number of failed test cases in this run.
+     */
+    int failed_test_cases_ = 0;
+
+    /**
+     * @brief How many times to execute the test suites, passed with
+     * `--repeat=N`; with `--until-fail`, 0 for no limit.
+     */
+    int repeat_ = 1;
+
+    /**
+     * @brief True if the repetitions stop after the first
+     * iteration with failures.
+     */
+    bool until_fail_ = false;
+
+    /**
+     * @brief The results of each test case, when repeating.
+     */
+    std::vector<detail::test_case_statistics> statistics_{};
+
+    /**
+     * @brief True while a registered test case is selected.
+     */
+    bool running_registered_ = false;
+
     /**
      * @brief Pointer to the default test suite which groups
      * the main tests.
@@ -113,6 +326,13 @@ namespace micro_os_plus::micro_test_plus
      * compilation units can  be automatically executed.
      */
     std::vector<test_suite_base*>* suites_;
+
+    /**
+     * @brief Pointer to array of registered test cases, in
+     * the order of their definition.
+     * Statically initialised to zero as BSS, like `suites_`.
+     */
+    std::vector<test_case_descriptor*>* test_cases_;
   };
 
   // --------------------------------------------------------------------------
@@ -81,10 +81,11 @@ namespace micro_os_plus::micro_test_plus
     /**
      * @brief Mark the beginning of a named test case.
      * @param [in] name The test case name.
-     * @par Returns
-     *  Nothing.
+     * @retval true The test case must be executed.
+     * @retval false The test case must be skipped, and
+     * `end_test_case()` must not be called.
      */
-    void
+    bool
     begin_test_case (const char* name);
 
     /**
@@ -109,6 +110,18 @@ namespace micro_os_plus::micro_test_plus
       return name_;
     }
 
+    /**
+     * @brief Get the name of the current test case.
+     * @par Parameters
+     *	None.
+     * @return A pointer to the null terminated test case name.
+     */
+    [[nodiscard]] constexpr const char*
+    test_case_name ()
+    {
+      return test_case_name_;
+    }
+
     /**
      * @brief Count one more passed test conditions.
      * @par Parameters
@@ -116,8 +129,12 @@ namespace micro_os_plus::micro_test_plus
      * @par Returns
      *  Nothing.
      */
-    void
-    increment_successful (void);
+    [[gnu::always_inline]] constexpr void
+    increment_successful (void)
+    {
+      ++successful_checks_;
+      ++current_test_case.successful_checks;
+    }
 
     /**
      * @brief Count one more failed test conditions.
@@ -211,6 +228,16 @@ namespace micro_os_plus::micro_test_plus
               && test_cases_ == 0);
     }
 
+    /**
+     * @brief Clear the counters, before running the test suite again.
+     * @par Parameters
+     *	None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    reset_counters (void);
+
   protected:
     /**
      * @brief The test suite name.
@@ -220,7 +247,7 @@ namespace micro_os_plus::micro_test_plus
     /**
      * @brief The current test case name.
      */
-    const char* test_case_name_;
+    const char* test_case_name_ = nullptr;
 
     /**
      * @brief Count of test conditions that passed.
@@ -290,6 +317,138 @@ namespace micro_os_plus::micro_test_plus
   };
 
   // --------------------------------------------------------------------------
+
+  /**
+   * @ingroup micro-test-plus-test-suites
+   * @brief Base class for the test cases registered to the runner,
+   * with the properties known before they are executed.
+   * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+   */
+  class test_case_descriptor
+  {
+  public:
+    /**
+     * @brief Construct a test case descriptor and register
+     * it to the runner.
+     * @param [in] suite The test suite, or `nullptr` for the
+     * default test suite.
+     * @param [in] name The test case name.
+     * @param [in] tags A possibly empty list of words separated
+     * by commas or spaces.
+     * @param [in] location The source location of the definition.
+     */
+    test_case_descriptor (test_suite_base* suite, const char* name,
+                          const char* tags,
+                          const reflection::source_location& location);
+
+    // The rule of five.
+    test_case_descriptor (const test_case_descriptor&) = delete;
+    test_case_descriptor (test_case_descriptor&&) = delete;
+    test_case_descriptor&
+    operator= (const test_case_descriptor&)
+        = delete;
+    test_case_descriptor&
+    operator= (test_case_descriptor&&)
+        = delete;
+
+    virtual ~test_case_descriptor ();
+
+    /**
+     * @brief Invoke the test case body.
+     */
+    virtual void
+    run (void)
+        = 0;
+
+    [[nodiscard]] constexpr test_suite_base*
+    suite (void) const
+    {
+      return suite_;
+    }
+
+    [[nodiscard]] constexpr const char*
+    name (void) const
+    {
+      return name_;
+    }
+
+    [[nodiscard]] constexpr const char*
+    tags (void) const
+    {
+      return tags_;
+    }
+
+    [[nodiscard]] constexpr const reflection::source_location&
+    location (void) const
+    {
+      return location_;
+    }
+
+    /**
+     * @brief Check if one of the tags is the given word.
+     */
+    [[nodiscard]] bool
+    has_tag (const char* tag) const;
+
+  protected:
+    test_suite_base* suite_;
+    const char* name_;
+    const char* tags_;
+    reflection::source_location location_;
+  };
+
+  /**
+   * @ingroup micro-test-plus-test-suites
+   * @brief Test cases which self register to the runner, to be
+   * executed after the test cases in `main()`.
+   * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+   *
+   * @details
+   * They are intended to be defined as static objects; the body
+   * is stored by value, thus no dynamic memory is used.
+   */
+  template <typename Callable_T>
+  class registered_test_case : public test_case_descriptor
+  {
+  public:
+    /**
+     * @brief Register a test case to the default test suite.
+     * @param [in] name The test case name or description.
+     * @param [in] callable A generic callable object, with no
+     * arguments, invoked to perform the test. Usually a lambda.
+     * @param [in] tags A possibly empty list of words separated
+     * by commas or spaces, used to select the test cases.
+     * @param [in] sl Optional source location, by default the current line.
+     */
+    registered_test_case (const char* name, Callable_T callable,
+                          const char* tags = "",
+                          const reflection::source_location& sl
+                          = reflection::source_location::current ());
+
+    /**
+     * @brief Register a test case to a test suite.
+     * @param [in] suite The test suite, which must be already
+     * constructed.
+     * @param [in] name The test case name or description.
+     * @param [in] callable A generic callable object, with no
+     * arguments, invoked to perform the test. Usually a lambda.
+     * @param [in] tags A possibly empty list of words separated
+     * by commas or spaces, used to select the test cases.
+     * @param [in] sl Optional source location, by default the current line.
+     */
+    registered_test_case (test_suite_base& suite, const char* name,
+                          Callable_T callable, const char* tags = "",
+                          const reflection::source_location& sl
+                          = reflection::source_location::current ());
+
+    virtual void
+    run (void) override;
+
+  protected:
+    Callable_T callable_;
+  };
+
+  // --------------------------------------------------------------------------
 } // namespace micro_os_plus::micro_test_plus
 
 #if defined(__GNUC__)
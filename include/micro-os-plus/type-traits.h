@@ -146,7 +146,8 @@ namespace micro_os_plus::micro_test_plus
 
     template <class T>
     static constexpr auto has_epsilon_v
-        = is_valid<T> ([] (auto t) -> decltype (void (t.epsilon)) {});
+        = is_valid<T> ([] (auto t) -> decltype (void (t.epsilon)) {})
+          or is_valid<T> ([] (auto t) -> decltype (void (t.epsilon_)) {});
 
     template <class T>
     inline constexpr auto is_floating_point_v = false;
@@ -333,6 +334,12 @@ namespace micro_os_plus::micro_test_plus
      * desired precision during comparisons.
      * If missing, the default is 1 / (10^decimals).
      * @headerfile micro-test-plus.h <micro-os-plus/micro-test-plus.h>
+     *
+     * @details
+     * The epsilon belongs to each instance, so values with different
+     * precisions (possibly in different threads) do not interfere.
+     * The constructors are `constexpr`, thus, when the value is a
+     * constant, the default epsilon is also computed at compile time.
      */
     template <class T>
     struct value<T,
@@ -340,11 +347,10 @@ namespace micro_os_plus::micro_test_plus
         : type_traits::op
     {
       using value_type = T;
-      static inline auto epsilon = T{}; // Why static?
 
-      constexpr value (const T& _value, const T precision) : value_{ _value }
+      constexpr value (const T& _value, const T precision)
+          : value_{ _value }, epsilon_{ precision }
       {
-        epsilon = precision;
       }
 
       constexpr /*explicit(false)*/ value (const T& val)
@@ -368,6 +374,7 @@ namespace micro_os_plus::micro_test_plus
       }
 
       T value_{};
+      T epsilon_{};
     };
 
   } // namespace type_traits
@@ -0,0 +1,264 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  namespace detail
+  {
+    namespace
+    {
+      /**
+       * @brief The tuples of values for a subset of `strength`
+       * parameters, with a flag for each tuple, set when covered.
+       */
+      struct subset
+      {
+        std::size_t first_parameter; // Index in `members`.
+        std::size_t offset; // Of the first flag.
+        std::size_t size; // The number of tuples.
+      };
+
+      // The value of a parameter not yet assigned.
+      constexpr std::size_t npos = std::numeric_limits<std::size_t>::max ();
+
+      /**
+       * @brief The index of the tuple of values of a row for a subset,
+       * or `npos` if some of its parameters have no value yet.
+       */
+      std::size_t
+      tuple_index (const std::size_t* parameters, std::size_t strength,
+                   const std::size_t* sizes, const std::size_t* row)
+      {
+        std::size_t index = 0;
+        for (std::size_t i = 0; i < strength; ++i)
+          {
+            const std::size_t value = row[parameters[i]];
+            if (value == npos)
+              {
+                return npos;
+              }
+            index = index * sizes[parameters[i]] + value;
+          }
+        return index;
+      }
+    } // namespace
+
+    /**
+     * @details
+     * The greedy algorithm builds one row at a time:
+     * - the row starts with the values of the first tuple not yet
+     *   covered, thus each row adds at least one tuple;
+     * - the other parameters are assigned in order, each with the
+     *   value that covers most new tuples together with the
+     *   parameters already assigned.
+     *
+     * The result is not minimal, but for pairs it is usually close
+     * to the optimum, and far smaller than the full product.
+     */
+    combinations_coverage
+    covering_array (const std::size_t* sizes, std::size_t parameters,
+                    std::size_t strength, std::size_t max_cases,
+                    std::vector<std::size_t>& rows)
+    {
+      combinations_coverage coverage{};
+      rows.clear ();
+
+      if (strength > parameters)
+        {
+          strength = parameters;
+        }
+      if (strength == 0)
+        {
+          strength = 1;
+        }
+      coverage.strength = strength;
+
+      coverage.product = 1;
+      for (std::size_t i = 0; i < parameters; ++i)
+        {
+          if (sizes[i] == 0)
+            {
+              coverage.product = 0;
+              return coverage;
+            }
+          if (coverage.product > std::numeric_limits<std::size_t>::max ()
+                                     / sizes[i])
+            {
+              coverage.product = std::numeric_limits<std::size_t>::max ();
+            }
+          else
+            {
+              coverage.product *= sizes[i];
+            }
+        }
+      if (parameters == 0)
+        {
+          return coverage;
+        }
+
+      // Enumerate all subsets of `strength` parameters,
+      // in lexicographic order.
+      std::vector<std::size_t> members; // `strength` for each subset.
+      std::vector<subset> subsets;
+      std::vector<std::size_t> current (strength);
+      for (std::size_t i = 0; i < strength; ++i)
+        {
+          current[i] = i;
+        }
+      for (;;)
+        {
+          std::size_t size = 1;
+          for (std::size_t i = 0; i < strength; ++i)
+            {
+              size *= sizes[current[i]];
+            }
+          subsets.push_back ({ members.size (), coverage.tuples, size });
+          members.insert (members.end (), current.begin (), current.end ());
+          coverage.tuples += size;
+
+          // Advance to the next subset.
+          std::size_t i = strength;
+          while (i > 0 and current[i - 1] == parameters - strength + i - 1)
+            {
+              --i;
+            }
+          if (i == 0)
+            {
+              break;
+            }
+          ++current[i - 1];
+          for (std::size_t j = i; j < strength; ++j)
+            {
+              current[j] = current[j - 1] + 1;
+            }
+        }
+
+      std::vector<std::uint8_t> covered (coverage.tuples, 0);
+      std::vector<std::size_t> row (parameters);
+      std::size_t first_uncovered = 0;
+
+      while (coverage.covered < coverage.tuples
+             and (max_cases == 0 or coverage.cases < max_cases))
+        {
+          while (covered[first_uncovered] != 0)
+            {
+              ++first_uncovered;
+            }
+
+          // Start with the values of the first uncovered tuple.
+          for (auto& value : row)
+            {
+              value = npos;
+            }
+          for (const auto& s : subsets)
+            {
+              if (first_uncovered < s.offset + s.size)
+                {
+                  std::size_t index = first_uncovered - s.offset;
+                  for (std::size_t i = strength; i > 0; --i)
+                    {
+                      const std::size_t p = members[s.first_parameter + i - 1];
+                      row[p] = index % sizes[p];
+                      index /= sizes[p];
+                    }
+                  break;
+                }
+            }
+
+          // Assign the other parameters.
+          for (std::size_t p = 0; p < parameters; ++p)
+            {
+              if (row[p] != npos)
+                {
+                  continue;
+                }
+              std::size_t best_value = 0;
+              std::size_t best_count = 0;
+              for (std::size_t v = 0; v < sizes[p]; ++v)
+                {
+                  row[p] = v;
+                  std::size_t count = 0;
+                  for (const auto& s : subsets)
+                    {
+                      const std::size_t* m = &members[s.first_parameter];
+                      bool has_p = false;
+                      for (std::size_t i = 0; i < strength; ++i)
+                        {
+                          has_p = has_p or (m[i] == p);
+                        }
+                      if (not has_p)
+                        {
+                          continue;
+                        }
+                      const std::size_t index
+                          = tuple_index (m, strength, sizes, row.data ());
+                      if (index != npos and covered[s.offset + index] == 0)
+                        {
+                          ++count;
+                        }
+                    }
+                  if (count > best_count)
+                    {
+                      best_count = count;
+                      best_value = v;
+                    }
+                }
+              row[p] = best_value;
+            }
+
+          // Mark the tuples covered by the new row.
+          for (const auto& s : subsets)
+            {
+              const std::size_t index = tuple_index (
+                  &members[s.first_parameter], strength, sizes, row.data ());
+              if (covered[s.offset + index] == 0)
+                {
+                  covered[s.offset + index] = 1;
+                  ++coverage.covered;
+                }
+            }
+
+          rows.insert (rows.end (), row.begin (), row.end ());
+          ++coverage.cases;
+        }
+
+      return coverage;
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,379 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ *
+ * Major parts of the code are inspired from v1.1.8 of the Boost UT project,
+ * released under the terms of the Boost Version 1.0 Software License,
+ * which can be obtained from <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  namespace detail
+  {
+    namespace
+    {
+      /**
+       * @brief Check if two floating point values are close.
+       *
+       * @details
+       * Two values are close if their difference is within the
+       * absolute tolerance, or within the relative tolerance scaled
+       * by the largest magnitude, or if they are at most `max_ulps`
+       * representable values apart. NaNs are never close.
+       *
+       * The ULP distance is computed on the bit patterns, mapped
+       * to integers that preserve the floating point order.
+       *
+       * There are no branches, so the loops calling it can be
+       * vectorised by the compiler, if the target has vector compares
+       * of integers of the same width as the values; on x86-64 with
+       * only SSE2 this is the case for `float`, but not for `double`,
+       * which needs SSE4.2.
+       */
+      template <class T, class Int_T, class Uint_T>
+      inline bool
+      is_close (T x, T y, T rel_tol, T abs_tol, Uint_T max_ulps)
+      {
+        constexpr int sign_shift = sizeof (Int_T) * 8 - 1;
+        constexpr Int_T magnitude_mask = std::numeric_limits<Int_T>::max ();
+
+        const T diff = std::fabs (x - y);
+        const T ax = std::fabs (x);
+        const T ay = std::fabs (y);
+        const T scaled_tol = rel_tol * (ax > ay ? ax : ay);
+        const bool within_tol
+            = diff <= (abs_tol > scaled_tol ? abs_tol : scaled_tol);
+
+        const Int_T ix = std::bit_cast<Int_T> (x);
+        const Int_T iy = std::bit_cast<Int_T> (y);
+        const Int_T ox = ix ^ ((ix >> sign_shift) & magnitude_mask);
+        const Int_T oy = iy ^ ((iy >> sign_shift) & magnitude_mask);
+        const Uint_T ux = static_cast<Uint_T> (ox);
+        const Uint_T uy = static_cast<Uint_T> (oy);
+        const Uint_T ulps = (ox > oy) ? ux - uy : uy - ux;
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+        const bool is_nan = (x != x) | (y != y);
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+        return (within_tol | (ulps <= max_ulps)) & !is_nan;
+      }
+
+      template <class T, class Int_T, class Uint_T>
+      close_result
+      all_close_impl (const T* lhs, const T* rhs, std::size_t size,
+                      double rel_tol, double abs_tol, std::uint64_t max_ulps)
+      {
+        const T rel = static_cast<T> (rel_tol);
+        const T abs = static_cast<T> (abs_tol);
+        const Uint_T ulps
+            = (max_ulps > std::numeric_limits<Uint_T>::max ())
+                  ? std::numeric_limits<Uint_T>::max ()
+                  : static_cast<Uint_T> (max_ulps);
+
+        close_result result{};
+
+        // The common case, when all values are close, is a single pass.
+        // The blocks have a constant number of elements, without
+        // remainder, so the inner loop is vectorised even with
+        // the cheapest cost model (the GCC default for -O2).
+        constexpr std::size_t block = 16;
+        std::size_t violations = 0;
+        std::size_t i = 0;
+        for (; i + block <= size; i += block)
+          {
+            Uint_T count = 0;
+            for (std::size_t j = 0; j < block; ++j)
+              {
+                count += is_close<T, Int_T, Uint_T> (lhs[i + j], rhs[i + j],
+                                                     rel, abs, ulps)
+                             ? 0u
+                             : 1u;
+              }
+            violations += count;
+          }
+        for (; i < size; ++i)
+          {
+            violations += is_close<T, Int_T, Uint_T> (lhs[i], rhs[i], rel,
+                                                      abs, ulps)
+                              ? 0u
+                              : 1u;
+          }
+        result.violations = violations;
+        if (violations == 0)
+          {
+            return result;
+          }
+
+        // Only on failure, a second pass identifies the worst element;
+        // a NaN is worse than any difference.
+        bool found = false;
+        for (std::size_t k = 0; k < size; ++k)
+          {
+            if (is_close<T, Int_T, Uint_T> (lhs[k], rhs[k], rel, abs, ulps))
+              {
+                continue;
+              }
+            const double error
+                = std::isnan (lhs[k]) || std::isnan (rhs[k])
+                      ? std::numeric_limits<double>::infinity ()
+                      : std::fabs (static_cast<double> (lhs[k])
+                                   - static_cast<double> (rhs[k]));
+            if (!found || error > result.worst_error)
+              {
+                found = true;
+                result.worst_index = k;
+                result.worst_error = error;
+              }
+          }
+        result.worst_lhs = static_cast<double> (lhs[result.worst_index]);
+        result.worst_rhs = static_cast<double> (rhs[result.worst_index]);
+
+        return result;
+      }
+    } // namespace
+
+    /**
+     * @details
+     * The memory is compared in the widest chunks available on the
+     * platform (32 bytes with AVX2, 16 bytes with SSE2 or NEON,
+     * a machine word otherwise); only the chunk that differs is
+     * inspected byte by byte.
+     */
+    std::size_t
+    mismatch_offset (const void* lhs, const void* rhs, std::size_t size)
+    {
+      const auto* l = static_cast<const unsigned char*> (lhs);
+      const auto* r = static_cast<const unsigned char*> (rhs);
+      std::size_t i = 0;
+
+#if defined(__AVX2__)
+      for (; i + 32 <= size; i += 32)
+        {
+          const __m256i a
+              = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (l + i));
+          const __m256i b
+              = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (r + i));
+          const auto mask = static_cast<std::uint32_t> (
+              _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (a, b)));
+          if (mask != 0xFFFFFFFFu)
+            {
+              return i + static_cast<std::size_t> (__builtin_ctz (~mask));
+            }
+        }
+#endif
+
+#if defined(__SSE2__)
+      for (; i + 16 <= size; i += 16)
+        {
+          const __m128i a
+              = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (l + i));
+          const __m128i b
+              = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (r + i));
+          const auto mask = static_cast<std::uint32_t> (
+              _mm_movemask_epi8 (_mm_cmpeq_epi8 (a, b)));
+          if (mask != 0xFFFFu)
+            {
+              return i + static_cast<std::size_t> (__builtin_ctz (~mask));
+            }
+        }
+#elif defined(__ARM_NEON)
+      for (; i + 16 <= size; i += 16)
+        {
+          const uint8x16_t eq = vceqq_u8 (vld1q_u8 (l + i), vld1q_u8 (r + i));
+#if defined(__aarch64__)
+          if (vminvq_u8 (eq) != 0xFF)
+            {
+              break;
+            }
+#else
+          const uint64x2_t eq64 = vreinterpretq_u64_u8 (eq);
+          if ((vgetq_lane_u64 (eq64, 0) & vgetq_lane_u64 (eq64, 1))
+              != ~std::uint64_t{})
+            {
+              break;
+            }
+#endif
+        }
+#endif
+
+      // Word-wide fallback; also locates the chunk that differs after
+      // the NEON loop. memcpy() is the portable way to read unaligned
+      // words, the compiler turns it into a single load.
+      for (; i + sizeof (std::uintptr_t) <= size;
+           i += sizeof (std::uintptr_t))
+        {
+          std::uintptr_t a;
+          std::uintptr_t b;
+          memcpy (&a, l + i, sizeof (a));
+          memcpy (&b, r + i, sizeof (b));
+          if (a != b)
+            {
+              break;
+            }
+        }
+
+      for (; i < size; ++i)
+        {
+          if (l[i] != r[i])
+            {
+              return i;
+            }
+        }
+
+      return size;
+    }
+
+    /**
+     * @details
+     * Same strategy as `mismatch_offset()`, with the pattern
+     * replicated in a register of the chunk width.
+     */
+    std::size_t
+    fill_mismatch_offset (const void* data, std::uint8_t pattern,
+                          std::size_t size)
+    {
+      const auto* d = static_cast<const unsigned char*> (data);
+      std::size_t i = 0;
+
+#if defined(__AVX2__)
+      const __m256i p32 = _mm256_set1_epi8 (static_cast<char> (pattern));
+      for (; i + 32 <= size; i += 32)
+        {
+          const __m256i a
+              = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (d + i));
+          const auto mask = static_cast<std::uint32_t> (
+              _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (a, p32)));
+          if (mask != 0xFFFFFFFFu)
+            {
+              return i + static_cast<std::size_t> (__builtin_ctz (~mask));
+            }
+        }
+#endif
+
+#if defined(__SSE2__)
+      const __m128i p16 = _mm_set1_epi8 (static_cast<char> (pattern));
+      for (; i + 16 <= size; i += 16)
+        {
+          const __m128i a
+              = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (d + i));
+          const auto mask = static_cast<std::uint32_t> (
+              _mm_movemask_epi8 (_mm_cmpeq_epi8 (a, p16)));
+          if (mask != 0xFFFFu)
+            {
+              return i + static_cast<std::size_t> (__builtin_ctz (~mask));
+            }
+        }
+#elif defined(__ARM_NEON)
+      const uint8x16_t p16 = vdupq_n_u8 (pattern);
+      for (; i + 16 <= size; i += 16)
+        {
+          const uint8x16_t eq = vceqq_u8 (vld1q_u8 (d + i), p16);
+#if defined(__aarch64__)
+          if (vminvq_u8 (eq) != 0xFF)
+            {
+              break;
+            }
+#else
+          const uint64x2_t eq64 = vreinterpretq_u64_u8 (eq);
+          if ((vgetq_lane_u64 (eq64, 0) & vgetq_lane_u64 (eq64, 1))
+              != ~std::uint64_t{})
+            {
+              break;
+            }
+#endif
+        }
+#endif
+
+      // 0x0101...01 times the pattern fills all bytes of the word.
+      const std::uintptr_t word
+          = (~std::uintptr_t{} / 0xFFu) * std::uintptr_t{ pattern };
+      for (; i + sizeof (std::uintptr_t) <= size;
+           i += sizeof (std::uintptr_t))
+        {
+          std::uintptr_t a;
+          memcpy (&a, d + i, sizeof (a));
+          if (a != word)
+            {
+              break;
+            }
+        }
+
+      for (; i < size; ++i)
+        {
+          if (d[i] != pattern)
+            {
+              return i;
+            }
+        }
+
+      return size;
+    }
+
+    close_result
+    all_close_values (const float* lhs, const float* rhs, std::size_t size,
+                      double rel_tol, double abs_tol, std::uint64_t max_ulps)
+    {
+      return all_close_impl<float, std::int32_t, std::uint32_t> (
+          lhs, rhs, size, rel_tol, abs_tol, max_ulps);
+    }
+
+    close_result
+    all_close_values (const double* lhs, const double* rhs, std::size_t size,
+                      double rel_tol, double abs_tol, std::uint64_t max_ulps)
+    {
+      return all_close_impl<double, std::int64_t, std::uint64_t> (
+          lhs, rhs, size, rel_tol, abs_tol, max_ulps);
+    }
+
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+// ----------------------------------------------------------------------------
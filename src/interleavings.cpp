@@ -0,0 +1,587 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  namespace detail
+  {
+    namespace
+    {
+      // No thread, before the first choice and after the last one.
+      constexpr std::size_t npos = std::numeric_limits<std::size_t>::max ();
+
+      /**
+       * @brief The scheduler of explore(), which lets a single
+       * thread run at a time, and chooses the next one at each
+       * scheduling point.
+       *
+       * @details
+       * The control is passed between threads with a mutex and
+       * a condition variable, which also make the effects of each
+       * thread visible to the next one.
+       *
+       * Only the scheduling points with more than one allowed
+       * choice are recorded, as decisions; since the schedules are
+       * deterministic, the same choices lead to the same decisions.
+       */
+      class explorer
+      {
+      public:
+        using failure = explore_::failure;
+
+        explorer (std::size_t threads, const explore_options& options);
+
+        void
+        run (const explore_callables& callables);
+
+        bool
+        next (void);
+
+        void
+        point (std::size_t self, bool voluntary);
+
+        bool
+        block (std::size_t self, const void* object);
+
+        void
+        release (const void* object);
+
+        [[nodiscard]] std::string
+        schedule (void) const;
+
+        failure failure_ = failure::none;
+        std::size_t preemptions_ = 0;
+
+      protected:
+        enum class state : std::uint8_t
+        {
+          runnable,
+          blocked,
+          finished,
+        };
+
+        struct decision
+        {
+          std::size_t index;
+          std::size_t alternatives;
+        };
+
+        std::size_t
+        choose (std::size_t self, bool voluntary);
+
+        std::size_t
+        choose_aborting (std::size_t self);
+
+        void
+        switch_to (std::size_t next, std::size_t self,
+                   std::unique_lock<std::mutex>& lock);
+
+        std::size_t threads_;
+        const explore_options& options_;
+        xoshiro128 prng_;
+
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::size_t running_ = npos;
+        bool done_ = false;
+        bool aborting_ = false;
+        std::size_t steps_ = 0;
+
+        std::vector<state> states_;
+        std::vector<const void*> blocked_on_;
+        std::vector<std::size_t> candidates_;
+
+        // The decisions of the current schedule.
+        std::vector<decision> decisions_;
+        // The choices to follow, from the previous schedule.
+        std::vector<std::size_t> prefix_;
+        // The threads chosen at each decision.
+        std::vector<std::size_t> trail_;
+        // The threads to choose, when replaying.
+        std::vector<std::size_t> replay_;
+      };
+
+      // The scheduler controlling the current thread, if any.
+      thread_local explorer* current_explorer = nullptr;
+      thread_local std::size_t current_thread = npos;
+
+      explorer::explorer (std::size_t threads, const explore_options& options)
+          : threads_{ threads }, options_{ options },
+            prng_{ options.seed != 0    ? options.seed
+                   : runner.seed () != 0 ? runner.seed ()
+                                         : 1 },
+            states_ (threads), blocked_on_ (threads)
+      {
+        candidates_.reserve (threads);
+        if (options.schedule != nullptr)
+          {
+            std::size_t value = 0;
+            bool has_value = false;
+            for (const char* p = options.schedule;; ++p)
+              {
+                if (*p >= '0' && *p <= '9')
+                  {
+                    value = value * 10 + static_cast<std::size_t> (*p - '0');
+                    has_value = true;
+                  }
+                else
+                  {
+                    if (has_value)
+                      {
+                        replay_.push_back (value);
+                      }
+                    value = 0;
+                    has_value = false;
+                    if (*p == '\0')
+                      {
+                        break;
+                      }
+                  }
+              }
+          }
+      }
+
+      /**
+       * @details
+       * The threads are created for each schedule, and wait for
+       * their turn before invoking the body.
+       */
+      void
+      explorer::run (const explore_callables& callables)
+      {
+        for (auto& s : states_)
+          {
+            s = state::runnable;
+          }
+        running_ = npos;
+        done_ = false;
+        aborting_ = false;
+        steps_ = 0;
+        preemptions_ = 0;
+        failure_ = failure::none;
+        decisions_.clear ();
+        trail_.clear ();
+
+        callables.setup (callables.setup_callable);
+
+        std::vector<std::thread> workers;
+        workers.reserve (threads_);
+        for (std::size_t t = 0; t < threads_; ++t)
+          {
+            workers.emplace_back ([this, &callables, t] {
+              current_explorer = this;
+              current_thread = t;
+              {
+                std::unique_lock<std::mutex> lock{ mutex_ };
+                condition_.wait (lock, [this, t] { return running_ == t; });
+              }
+
+              const bool passed
+                  = callables.body (callables.body_callable, t);
+
+              std::unique_lock<std::mutex> lock{ mutex_ };
+              if (not passed && failure_ == failure::none)
+                {
+                  failure_ = failure::body;
+                }
+              states_[t] = state::finished;
+              switch_to (choose (t, true), t, lock);
+              current_explorer = nullptr;
+            });
+          }
+
+        {
+          std::unique_lock<std::mutex> lock{ mutex_ };
+          running_ = choose (npos, false);
+          condition_.notify_all ();
+          condition_.wait (lock, [this] { return done_; });
+        }
+
+        for (auto& worker : workers)
+          {
+            worker.join ();
+          }
+      }
+
+      /**
+       * @details
+       * In systematic mode, the last decision which still has
+       * alternatives is advanced, and the ones after it are
+       * dropped, to be taken by default; this is a depth first
+       * search of the tree of schedules.
+       */
+      bool
+      explorer::next (void)
+      {
+        if (not replay_.empty ())
+          {
+            return false;
+          }
+        if (options_.random)
+          {
+            return true;
+          }
+
+        while (not decisions_.empty ()
+               && decisions_.back ().index + 1
+                      >= decisions_.back ().alternatives)
+          {
+            decisions_.pop_back ();
+          }
+        if (decisions_.empty ())
+          {
+            return false;
+          }
+
+        prefix_.clear ();
+        for (const auto& d : decisions_)
+          {
+            prefix_.push_back (d.index);
+          }
+        ++prefix_.back ();
+        return true;
+      }
+
+      void
+      explorer::point (std::size_t self, bool voluntary)
+      {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        if (++steps_ > options_.max_steps && not aborting_)
+          {
+            if (failure_ == failure::none)
+              {
+                failure_ = failure::steps;
+              }
+            aborting_ = true;
+          }
+        switch_to (choose (self, voluntary), self, lock);
+      }
+
+      bool
+      explorer::block (std::size_t self, const void* object)
+      {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        if (aborting_)
+          {
+            return false;
+          }
+        states_[self] = state::blocked;
+        blocked_on_[self] = object;
+        switch_to (choose (self, false), self, lock);
+        // Either released, or aborting.
+        states_[self] = state::runnable;
+        return not aborting_;
+      }
+
+      void
+      explorer::release (const void* object)
+      {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        for (std::size_t t = 0; t < threads_; ++t)
+          {
+            if (states_[t] == state::blocked && blocked_on_[t] == object)
+              {
+                states_[t] = state::runnable;
+              }
+          }
+      }
+
+      std::string
+      explorer::schedule (void) const
+      {
+        std::string result;
+        for (std::size_t i = 0; i < trail_.size (); ++i)
+          {
+            if (i > 0)
+              {
+                result.append (".");
+              }
+            result.append (std::to_string (trail_[i]));
+          }
+        return result;
+      }
+
+      /**
+       * @details
+       * The candidates are ordered such that the first one is the
+       * default choice, which does not preempt: the current thread
+       * if it can continue, otherwise the next one in round robin
+       * order. For voluntary switches, the current thread is the
+       * last choice.
+       */
+      std::size_t
+      explorer::choose (std::size_t self, bool voluntary)
+      {
+        if (aborting_)
+          {
+            return choose_aborting (self);
+          }
+
+        const bool self_runnable
+            = (self != npos && states_[self] == state::runnable);
+        candidates_.clear ();
+        if (self_runnable && not voluntary)
+          {
+            candidates_.push_back (self);
+          }
+        const std::size_t first = (self == npos) ? 0 : self + 1;
+        for (std::size_t i = 0; i < threads_; ++i)
+          {
+            const std::size_t t = (first + i) % threads_;
+            if (t != self && states_[t] == state::runnable)
+              {
+                candidates_.push_back (t);
+              }
+          }
+        if (self_runnable && voluntary)
+          {
+            candidates_.push_back (self);
+          }
+
+        if (candidates_.empty ())
+          {
+            for (const auto& s : states_)
+              {
+                if (s != state::finished)
+                  {
+                    // All the other threads are blocked.
+                    if (failure_ == failure::none)
+                      {
+                        failure_ = failure::deadlock;
+                      }
+                    aborting_ = true;
+                    return choose_aborting (self);
+                  }
+              }
+            return npos;
+          }
+
+        const bool can_preempt = self_runnable && not voluntary;
+        if (can_preempt && preemptions_ >= options_.preemption_bound)
+          {
+            // Only the current thread is allowed.
+            candidates_.resize (1);
+          }
+        if (candidates_.size () == 1)
+          {
+            return candidates_[0];
+          }
+
+        std::size_t index = 0;
+        const std::size_t k = decisions_.size ();
+        if (not replay_.empty ())
+          {
+            for (std::size_t i = 0; i < candidates_.size (); ++i)
+              {
+                if (k < replay_.size () && candidates_[i] == replay_[k])
+                  {
+                    index = i;
+                  }
+              }
+          }
+        else if (options_.random)
+          {
+            index = prng_.next () % candidates_.size ();
+          }
+        else if (k < prefix_.size () && prefix_[k] < candidates_.size ())
+          {
+            index = prefix_[k];
+          }
+
+        decisions_.push_back ({ index, candidates_.size () });
+        trail_.push_back (candidates_[index]);
+        if (can_preempt && index != 0)
+          {
+            ++preemptions_;
+          }
+        return candidates_[index];
+      }
+
+      /**
+       * @details
+       * After a failure, the threads run to the end one after the
+       * other, in round robin order, without waiting for mutexes.
+       */
+      std::size_t
+      explorer::choose_aborting (std::size_t self)
+      {
+        const std::size_t first = (self == npos) ? 0 : self + 1;
+        for (std::size_t i = 0; i < threads_; ++i)
+          {
+            const std::size_t t = (first + i) % threads_;
+            if (states_[t] != state::finished)
+              {
+                return t;
+              }
+          }
+        return npos;
+      }
+
+      void
+      explorer::switch_to (std::size_t next, std::size_t self,
+                           std::unique_lock<std::mutex>& lock)
+      {
+        if (next == self)
+          {
+            return;
+          }
+        running_ = next;
+        if (next == npos)
+          {
+            done_ = true;
+          }
+        condition_.notify_all ();
+        if (states_[self] != state::finished)
+          {
+            condition_.wait (lock, [this, self] { return running_ == self; });
+          }
+      }
+    } // namespace
+
+    bool
+    is_exploring (void)
+    {
+      return current_explorer != nullptr;
+    }
+
+    void
+    schedule_point (bool voluntary)
+    {
+      if (current_explorer != nullptr)
+        {
+          current_explorer->point (current_thread, voluntary);
+        }
+    }
+
+    bool
+    schedule_block (const void* object)
+    {
+      if (current_explorer != nullptr)
+        {
+          return current_explorer->block (current_thread, object);
+        }
+      return false;
+    }
+
+    void
+    schedule_release (const void* object)
+    {
+      if (current_explorer != nullptr)
+        {
+          current_explorer->release (object);
+        }
+    }
+
+    /**
+     * @details
+     * The checks issued by the threads are counted before and
+     * after each schedule, to stop at the first schedule in
+     * which some of them failed.
+     */
+    explore_
+    run_explore (std::size_t threads, const explore_callables& callables,
+                 const explore_options& options)
+    {
+      if (threads == 0)
+        {
+          threads = 1;
+        }
+
+      explorer scheduler{ threads, options };
+      std::size_t schedules = 0;
+      std::size_t failed_checks = 0;
+      bool exhausted = false;
+      for (;;)
+        {
+          const std::size_t failed_checks_before = worker_failed_checks ();
+          scheduler.run (callables);
+          ++schedules;
+
+          failed_checks = worker_failed_checks () - failed_checks_before;
+          if (scheduler.failure_ == explore_::failure::none
+              && failed_checks > 0)
+            {
+              scheduler.failure_ = explore_::failure::checks;
+            }
+          if (not callables.check (callables.check_callable)
+              && scheduler.failure_ == explore_::failure::none)
+            {
+              scheduler.failure_ = explore_::failure::check;
+            }
+
+          if (scheduler.failure_ != explore_::failure::none)
+            {
+              break;
+            }
+          if (not scheduler.next ())
+            {
+              exhausted = (options.schedule == nullptr);
+              break;
+            }
+          if (options.max_schedules != 0 && schedules >= options.max_schedules)
+            {
+              break;
+            }
+        }
+
+      const bool failed = (scheduler.failure_ != explore_::failure::none);
+      return explore_{ {},
+                       not failed,
+                       scheduler.failure_,
+                       threads,
+                       schedules,
+                       options.schedule != nullptr ? 1 : options.max_schedules,
+                       exhausted,
+                       options.random,
+                       options.schedule != nullptr,
+                       options.preemption_bound,
+                       scheduler.preemptions_,
+                       failed_checks,
+                       failed ? scheduler.schedule () : std::string{} };
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+#endif // defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,203 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  namespace detail
+  {
+    namespace
+    {
+      /**
+       * @brief The invocation or the return of an operation, in a
+       * list ordered by time; the operations are removed from the
+       * list while they are part of the current sequence.
+       */
+      struct event
+      {
+        std::size_t operation;
+        std::size_t time;
+        std::size_t prev;
+        std::size_t next;
+        // For invocations, the index of the return event.
+        std::size_t match;
+        bool is_call;
+      };
+    } // namespace
+
+    /**
+     * @details
+     * The events are scanned in order of time. At each invocation,
+     * the operation is tentatively added to the sequence; if the
+     * model gives the same result, and the state with this set of
+     * operations is new, the operation is removed from the list, and
+     * the scan restarts. When reaching the return of an operation
+     * not yet in the sequence, there is no valid order with the
+     * current sequence, thus its last operation is put back, and the
+     * scan continues after it.
+     *
+     * The operations that did not return have the return at the
+     * end; reaching it means all the other ones were ordered.
+     */
+    linearizability_result
+    check_linearizability (const std::size_t* times, std::size_t operations,
+                           linearizability_model& model,
+                           std::size_t max_states)
+    {
+      constexpr std::size_t infinity = std::numeric_limits<std::size_t>::max ();
+
+      linearizability_result result{ true, false, 0, 0, operations };
+      if (operations == 0)
+        {
+          return result;
+        }
+
+      // Sort the events, and link them in a list, with
+      // the head at the end.
+      const std::size_t head = 2 * operations;
+      std::vector<event> events (head + 1);
+      std::vector<std::size_t> order (head);
+      for (std::size_t i = 0; i < operations; ++i)
+        {
+          const std::size_t returned = times[2 * i + 1];
+          events[2 * i] = { i, times[2 * i], 0, 0, 2 * i + 1, true };
+          events[2 * i + 1]
+              = { i, returned == 0 ? infinity : returned, 0, 0, 0, false };
+          order[2 * i] = 2 * i;
+          order[2 * i + 1] = 2 * i + 1;
+        }
+      std::sort (order.begin (), order.end (),
+                 [&events] (std::size_t a, std::size_t b) {
+                   if (events[a].time != events[b].time)
+                     {
+                       return events[a].time < events[b].time;
+                     }
+                   return a < b;
+                 });
+      std::size_t prev = head;
+      for (const std::size_t index : order)
+        {
+          events[prev].next = index;
+          events[index].prev = prev;
+          prev = index;
+        }
+      events[prev].next = head;
+      events[head].prev = prev;
+
+      const auto unlink = [&events] (std::size_t index) {
+        events[events[index].prev].next = events[index].next;
+        events[events[index].next].prev = events[index].prev;
+      };
+      const auto relink = [&events] (std::size_t index) {
+        events[events[index].prev].next = index;
+        events[events[index].next].prev = index;
+      };
+
+      std::vector<std::uint64_t> set ((operations + 63) / 64, 0);
+      std::vector<std::size_t> sequence;
+      sequence.reserve (operations);
+      std::size_t stuck_depth = 0;
+
+      std::size_t current = events[head].next;
+      while (current != head)
+        {
+          const event& e = events[current];
+          if (e.is_call)
+            {
+              const std::size_t depth = sequence.size ();
+              const std::uint64_t bit = std::uint64_t{ 1 }
+                                        << (e.operation % 64);
+              if (model.apply (depth, e.operation))
+                {
+                  set[e.operation / 64] |= bit;
+                  if (model.remember (depth + 1, set))
+                    {
+                      if (++result.states > max_states)
+                        {
+                          result.linearizable = false;
+                          result.gave_up = true;
+                          return result;
+                        }
+                      sequence.push_back (current);
+                      result.longest = std::max (result.longest,
+                                                 sequence.size ());
+                      unlink (e.match);
+                      unlink (current);
+                      current = events[head].next;
+                      continue;
+                    }
+                  set[e.operation / 64] &= ~bit;
+                }
+              current = e.next;
+            }
+          else
+            {
+              if (e.time == infinity)
+                {
+                  // Only operations that did not return are left.
+                  return result;
+                }
+              if (result.stuck == operations
+                  || sequence.size () > stuck_depth)
+                {
+                  stuck_depth = sequence.size ();
+                  result.stuck = e.operation;
+                }
+              if (sequence.empty ())
+                {
+                  result.linearizable = false;
+                  return result;
+                }
+
+              // Backtrack.
+              const std::size_t last = sequence.back ();
+              sequence.pop_back ();
+              const std::size_t operation = events[last].operation;
+              set[operation / 64] &= ~(std::uint64_t{ 1 } << (operation % 64));
+              relink (last);
+              relink (events[last].match);
+              current = events[last].next;
+            }
+        }
+
+      return result;
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+// ----------------------------------------------------------------------------
@@ -26,9 +26,18 @@
 #include <stdio.h>
 #include <unistd.h>
 
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+#endif
+
 // ----------------------------------------------------------------------------
 
 #pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
 #if defined(__clang__)
 #pragma clang diagnostic ignored "-Wc++98-compat"
 #pragma clang diagnostic ignored "-Wexit-time-destructors"
@@ -158,34 +167,472 @@ namespace micro_os_plus::micro_test_plus
 
   namespace detail
   {
-    deferred_reporter_base::deferred_reporter_base (
-        bool value, const reflection::source_location location)
-        : value_{ value }, location_{ location }
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+    thread_local constinit bool in_runner_thread = false;
+
+    namespace
+    {
+      /**
+       * @brief A reporter for the checks issued by a thread,
+       * which formats the messages one at a time.
+       */
+      class thread_reporter : public test_reporter
+      {
+      public:
+        thread_reporter ()
+        {
+          verbosity = reporter.verbosity;
+          is_in_test_case_ = true;
+        }
+
+        std::string&
+        text (void)
+        {
+          return out_;
+        }
+      };
+
+      /**
+       * @brief A message of a thread, with its global sequence number,
+       * used to merge the messages of all threads in order.
+       */
+      struct thread_message
+      {
+        std::uint64_t sequence;
+        std::string text;
+      };
+
+      /**
+       * @brief The state of a thread which issues checks, other
+       * than the runner thread.
+       *
+       * @details
+       * The counters and the messages are written only by the thread,
+       * thus the appends do not compete; the runner reads them
+       * at the end of the test case.
+       *
+       * The messages are kept in a single producer, single consumer
+       * ring, preallocated when the thread issues its first check;
+       * the append is wait-free. The last slots are reserved for
+       * failures; when they are reached, the messages of the passed
+       * checks are dropped, and only counted. The failures are never
+       * dropped: when the ring is full, they are kept with the
+       * messages of the threads already terminated.
+       *
+       * The strings are swapped into the ring and moved out of it,
+       * not copied; the runner reserves new buffers for the slots it
+       * consumes, thus the thread does not allocate after the first
+       * check.
+       */
+      class thread_state
+      {
+      public:
+        thread_state ();
+
+        thread_state (const thread_state&) = delete;
+        thread_state (thread_state&&) = delete;
+        thread_state&
+        operator= (const thread_state&)
+            = delete;
+        thread_state&
+        operator= (thread_state&&)
+            = delete;
+
+        ~thread_state ();
+
+        void
+        append (std::string& text, bool failed);
+
+        void
+        consume (std::vector<thread_message>& messages);
+
+        static constexpr std::size_t capacity = 256;
+        static constexpr std::size_t reserved = capacity / 4;
+        static constexpr std::size_t text_capacity = 160;
+
+        thread_reporter reporter_{};
+        std::atomic<int> successful_{ 0 };
+        std::atomic<int> failed_{ 0 };
+        std::atomic<std::size_t> dropped_{ 0 };
+        thread_state* next_ = nullptr;
+
+      protected:
+        std::vector<thread_message> ring_;
+        // Written by the thread.
+        std::atomic<std::size_t> head_{ 0 };
+        // Written by the runner.
+        std::atomic<std::size_t> tail_{ 0 };
+      };
+
+      // The order of the messages of all threads.
+      std::atomic<std::uint64_t> sequence{ 0 };
+
+      /**
+       * @brief The start of the message of a check issued by the
+       * runner thread in the reporter buffer.
+       */
+      struct runner_mark
+      {
+        std::uint64_t sequence;
+        std::size_t offset;
+      };
+
+      // Used only by the runner thread, after other threads issued
+      // checks.
+      std::vector<runner_mark> runner_marks;
+
+      // The list of threads and the state of the threads already
+      // terminated, guarded by `mutex`; the threads lock it only
+      // when they start and when they terminate, or when a failure
+      // does not fit in the ring.
+      std::mutex mutex;
+      thread_state* threads = nullptr;
+      int orphan_successful = 0;
+      int orphan_failed = 0;
+      std::size_t orphan_dropped = 0;
+      std::vector<thread_message> orphan_messages;
+
+      // Set when the first check is issued by another thread;
+      // until then the runner does not need to lock the mutex.
+      std::atomic<bool> has_workers{ false };
+
+      thread_state::thread_state () : ring_ (capacity)
+      {
+        reporter_.text ().reserve (text_capacity);
+        for (auto& message : ring_)
+          {
+            message.text.reserve (text_capacity);
+          }
+
+        std::lock_guard<std::mutex> lock{ mutex };
+        next_ = threads;
+        threads = this;
+        has_workers.store (true, std::memory_order_release);
+      }
+
+      thread_state::~thread_state ()
+      {
+        std::lock_guard<std::mutex> lock{ mutex };
+        orphan_successful += successful_.load (std::memory_order_relaxed);
+        orphan_failed += failed_.load (std::memory_order_relaxed);
+        orphan_dropped += dropped_.load (std::memory_order_relaxed);
+        consume (orphan_messages);
+        for (thread_state** p = &threads; *p != nullptr; p = &(*p)->next_)
+          {
+            if (*p == this)
+              {
+                *p = next_;
+                break;
+              }
+          }
+      }
+
+      void
+      thread_state::append (std::string& text, bool failed)
+      {
+        const std::size_t head = head_.load (std::memory_order_relaxed);
+        const std::size_t used = head - tail_.load (std::memory_order_acquire);
+        if (used == capacity || (not failed && used >= capacity - reserved))
+          {
+            if (failed)
+              {
+                std::lock_guard<std::mutex> lock{ mutex };
+                orphan_messages.push_back (
+                    { sequence.fetch_add (1, std::memory_order_relaxed),
+                      text });
+              }
+            else
+              {
+                dropped_.fetch_add (1, std::memory_order_relaxed);
+              }
+            text.clear ();
+            return;
+          }
+
+        thread_message& message = ring_[head % capacity];
+        message.sequence = sequence.fetch_add (1, std::memory_order_relaxed);
+        message.text.swap (text);
+        text.clear ();
+        head_.store (head + 1, std::memory_order_release);
+      }
+
+      void
+      thread_state::consume (std::vector<thread_message>& messages)
+      {
+        const std::size_t tail = tail_.load (std::memory_order_relaxed);
+        const std::size_t head = head_.load (std::memory_order_acquire);
+        for (std::size_t i = tail; i != head; ++i)
+          {
+            thread_message& message = ring_[i % capacity];
+            messages.push_back (
+                { message.sequence, std::move (message.text) });
+            message.text.clear ();
+            message.text.reserve (text_capacity);
+          }
+        tail_.store (head, std::memory_order_release);
+      }
+
+      thread_state&
+      current_thread_state (void)
+      {
+        thread_local thread_state state;
+        return state;
+      }
+
+      /**
+       * @brief Move the messages of all threads to the vector, in the
+       * order they were issued; called with `mutex` locked.
+       * @return The number of messages dropped.
+       */
+      std::size_t
+      collect_messages (std::vector<thread_message>& messages)
+      {
+        std::size_t dropped = orphan_dropped;
+        orphan_dropped = 0;
+
+        messages.swap (orphan_messages);
+        for (thread_state* state = threads; state != nullptr;
+             state = state->next_)
+          {
+            dropped += state->dropped_.exchange (0);
+            state->consume (messages);
+          }
+
+        std::sort (messages.begin (), messages.end (),
+                   [] (const thread_message& a, const thread_message& b) {
+                     return a.sequence < b.sequence;
+                   });
+        return dropped;
+      }
+    } // namespace
+
+    void
+    count_worker_check (bool value)
     {
-      if (value_)
+      thread_state& state = current_thread_state ();
+      if (value)
         {
-          current_test_suite->increment_successful ();
+          state.successful_.fetch_add (1, std::memory_order_relaxed);
         }
       else
         {
-          current_test_suite->increment_failed ();
+          state.failed_.fetch_add (1, std::memory_order_relaxed);
+        }
+    }
+
+    test_reporter&
+    worker_reporter (void)
+    {
+      return current_thread_state ().reporter_;
+    }
+
+    void
+    release_worker_reporter (bool value)
+    {
+      thread_state& state = current_thread_state ();
+      if (not state.reporter_.text ().empty ())
+        {
+          state.append (state.reporter_.text (), not value);
+        }
+    }
+
+    void
+    mark_runner_check (void)
+    {
+      const std::size_t offset = reporter.out_.size ();
+      if (not runner_marks.empty () && offset < runner_marks.back ().offset)
+        {
+          // The buffer was displayed meanwhile.
+          runner_marks.clear ();
+        }
+      runner_marks.push_back (
+          { sequence.fetch_add (1, std::memory_order_relaxed), offset });
+    }
+
+    /**
+     * @details
+     * The messages of all threads are sorted by their sequence
+     * numbers, and each one is inserted in the reporter buffer before
+     * the first message of the runner thread issued after it.
+     *
+     * The checks issued by other threads after the end of a test
+     * case are accounted to the next test case, thus the threads
+     * should be joined before the test case returns.
+     */
+    void
+    merge_worker_checks (test_suite_base& suite)
+    {
+      if (not has_workers.load (std::memory_order_acquire))
+        {
+          // Only the runner thread issued checks.
+          return;
         }
+
+      std::lock_guard<std::mutex> lock{ mutex };
+      int successful = orphan_successful;
+      int failed = orphan_failed;
+      orphan_successful = 0;
+      orphan_failed = 0;
+      for (thread_state* state = threads; state != nullptr;
+           state = state->next_)
+        {
+          successful += state->successful_.exchange (0);
+          failed += state->failed_.exchange (0);
+        }
+
+      std::vector<thread_message> messages;
+      const std::size_t dropped = collect_messages (messages);
+
+      for (; successful > 0; --successful)
+        {
+          suite.increment_successful ();
+        }
+      for (; failed > 0; --failed)
+        {
+          suite.increment_failed ();
+        }
+
+      std::string& text = reporter.out_;
+      if (not runner_marks.empty ()
+          && runner_marks.back ().offset > text.size ())
+        {
+          // The buffer was displayed after the last mark.
+          runner_marks.clear ();
+        }
+
+      std::string merged;
+      std::size_t position = 0;
+      auto message = messages.begin ();
+      for (const auto& mark : runner_marks)
+        {
+          for (; message != messages.end ()
+                 && message->sequence < mark.sequence;
+               ++message)
+            {
+              merged.append (text, position, mark.offset - position);
+              position = mark.offset;
+              merged.append (message->text);
+            }
+        }
+      runner_marks.clear ();
+      merged.append (text, position);
+      for (; message != messages.end (); ++message)
+        {
+          merged.append (message->text);
+        }
+      text.swap (merged);
+
+      if (dropped > 0)
+        {
+          reporter << "      ... "
+                   << std::string_view{ std::to_string (dropped) }
+                   << " more passed check" << (dropped == 1 ? "" : "s")
+                   << " from other threads\n";
+        }
+    }
+
+    /**
+     * @details
+     * The messages are displayed directly, since the reporter
+     * belongs to the runner thread, which may still use it.
+     */
+    void
+    output_worker_checks (void)
+    {
+      std::lock_guard<std::mutex> lock{ mutex };
+      std::vector<thread_message> messages;
+      const std::size_t dropped = collect_messages (messages);
+      for (const auto& message : messages)
+        {
+          printf ("%s", message.text.c_str ());
+        }
+      if (dropped > 0)
+        {
+          printf ("      ... %zu more passed check%s from other threads\n",
+                  dropped, dropped == 1 ? "" : "s");
+        }
+      fflush (stdout);
+    }
+
+    std::size_t
+    worker_failed_checks (void)
+    {
+      std::lock_guard<std::mutex> lock{ mutex };
+      int failed = orphan_failed;
+      for (thread_state* state = threads; state != nullptr;
+           state = state->next_)
+        {
+          failed += state->failed_.load (std::memory_order_relaxed);
+        }
+      return static_cast<std::size_t> (failed);
+    }
+#endif // defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
+    /**
+     * @details
+     * The passed checks issued by the runner thread were already
+     * counted inline.
+     */
+    void
+    deferred_reporter_base::report_pass_ (const void* expr,
+                                          pass_output_t output)
+    {
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+      if (not is_runner_thread ())
+        {
+          count_worker_check (true);
+          output (worker_reporter (), expr, message_);
+          release_worker_reporter (true);
+          return;
+        }
+      if (has_workers.load (std::memory_order_relaxed))
+        {
+          mark_runner_check ();
+        }
+#endif
+      output (reporter, expr, message_);
     }
 
-    deferred_reporter_base::~deferred_reporter_base ()
+    void
+    deferred_reporter_base::report_fail_ (const void* expr,
+                                          fail_output_t output)
     {
-#if 0 // defined(MICRO_TEST_PLUS_TRACE)
-      printf ("%s\n", __PRETTY_FUNCTION__);
-#endif // MICRO_TEST_PLUS_TRACE
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+      if (not is_runner_thread ())
+        {
+          count_worker_check (false);
+          output (worker_reporter (), expr, abort_, message_, location_);
+          release_worker_reporter (false);
+          if (abort_)
+            {
+              printf ("\n");
+              // The failure is in the thread buffer, not in the
+              // runner reporter.
+              output_worker_checks ();
+              runner.abort ();
+            }
+          return;
+        }
+      if (has_workers.load (std::memory_order_relaxed))
+        {
+          mark_runner_check ();
+        }
+#endif
+      current_test_suite->increment_failed ();
+      output (reporter, expr, abort_, message_, location_);
 
-      if (abort_ && !value_)
+      if (abort_)
         {
           printf ("\n");
           reporter.output ();
-          abort ();
+          runner.abort ();
         }
     }
 
+    // Used by the lite mode; always instantiated, so that the
+    // library does not depend on the application configuration.
+    template class deferred_reporter<lite_expression>;
+
   } // namespace detail
 
   // ==========================================================================
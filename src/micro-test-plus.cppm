@@ -0,0 +1,283 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ *
+ * Major parts of the code are inspired from v1.1.8 of the Boost UT project,
+ * released under the terms of the Boost Version 1.0 Software License,
+ * which can be obtained from <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+
+// ----------------------------------------------------------------------------
+
+// The C++20 module interface of µTest++.
+//
+// The module is built from the same headers, included in the
+// global module fragment, and only re-exports the public API,
+// so that test sources can use:
+//
+// `import micro_os_plus.micro_test_plus;`
+//
+// instead of including `<micro-os-plus/micro-test-plus.h>`.
+
+module;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+export module micro_os_plus.micro_test_plus;
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+export namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+  // Globals.
+
+  using micro_test_plus::current_test_suite;
+  using micro_test_plus::reporter;
+  using micro_test_plus::runner;
+
+  // --------------------------------------------------------------------------
+  // Classes.
+
+  using micro_test_plus::test_reporter;
+  using micro_test_plus::test_runner;
+  using micro_test_plus::test_suite;
+  using micro_test_plus::test_suite_base;
+  using micro_test_plus::test_case_descriptor;
+  using micro_test_plus::registered_test_case;
+  using micro_test_plus::endl;
+
+  // --------------------------------------------------------------------------
+  // Public API.
+
+  using micro_test_plus::exit_code;
+  using micro_test_plus::initialize;
+  using micro_test_plus::test_case;
+
+  using micro_test_plus::combinations;
+  using micro_test_plus::combinations_options;
+  using micro_test_plus::table_case;
+
+  using micro_test_plus::property;
+  using micro_test_plus::property_options;
+
+  using micro_test_plus::history;
+  using micro_test_plus::linearizable;
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+  using micro_test_plus::stress;
+
+  using micro_test_plus::explore;
+  using micro_test_plus::explore_options;
+#endif
+
+  using micro_test_plus::assume;
+  using micro_test_plus::expect;
+#if defined(__cpp_nontype_template_args) \
+    && (__cpp_nontype_template_args >= 201911L)
+  using micro_test_plus::static_expect;
+#endif
+
+  using micro_test_plus::eq;
+  using micro_test_plus::ge;
+  using micro_test_plus::gt;
+  using micro_test_plus::le;
+  using micro_test_plus::lt;
+  using micro_test_plus::ne;
+
+  using micro_test_plus::all_close;
+  using micro_test_plus::eq_bytes;
+  using micro_test_plus::eq_range;
+  using micro_test_plus::filled_with;
+
+  using micro_test_plus::_and;
+  using micro_test_plus::_not;
+  using micro_test_plus::_or;
+
+#if defined(__cpp_exceptions)
+  using micro_test_plus::nothrow;
+  using micro_test_plus::throws;
+#endif
+
+  using micro_test_plus::mut;
+
+  // --------------------------------------------------------------------------
+  // Wrappers.
+
+  using micro_test_plus::_b;
+  using micro_test_plus::_c;
+  using micro_test_plus::_d;
+  using micro_test_plus::_f;
+  using micro_test_plus::_i;
+  using micro_test_plus::_i16;
+  using micro_test_plus::_i32;
+  using micro_test_plus::_i64;
+  using micro_test_plus::_i8;
+  using micro_test_plus::_l;
+  using micro_test_plus::_ld;
+  using micro_test_plus::_ll;
+  using micro_test_plus::_s;
+  using micro_test_plus::_sc;
+  using micro_test_plus::_t;
+  using micro_test_plus::_u;
+  using micro_test_plus::_u16;
+  using micro_test_plus::_u32;
+  using micro_test_plus::_u64;
+  using micro_test_plus::_u8;
+  using micro_test_plus::_uc;
+  using micro_test_plus::_ul;
+  using micro_test_plus::_ull;
+  using micro_test_plus::_us;
+
+  using micro_test_plus::to_b;
+  using micro_test_plus::to_c;
+  using micro_test_plus::to_d;
+  using micro_test_plus::to_f;
+  using micro_test_plus::to_i;
+  using micro_test_plus::to_i16;
+  using micro_test_plus::to_i32;
+  using micro_test_plus::to_i64;
+  using micro_test_plus::to_i8;
+  using micro_test_plus::to_l;
+  using micro_test_plus::to_ld;
+  using micro_test_plus::to_ll;
+  using micro_test_plus::to_s;
+  using micro_test_plus::to_sc;
+  using micro_test_plus::to_t;
+  using micro_test_plus::to_u;
+  using micro_test_plus::to_u16;
+  using micro_test_plus::to_u32;
+  using micro_test_plus::to_u64;
+  using micro_test_plus::to_u8;
+  using micro_test_plus::to_uc;
+  using micro_test_plus::to_ul;
+  using micro_test_plus::to_ull;
+  using micro_test_plus::to_us;
+
+  // --------------------------------------------------------------------------
+
+  namespace operators
+  {
+    using operators::operator==;
+    using operators::operator!=;
+    using operators::operator<;
+    using operators::operator<=;
+    using operators::operator>;
+    using operators::operator>=;
+    using operators::operator and;
+    using operators::operator or;
+    using operators::operator not;
+  } // namespace operators
+
+  namespace literals
+  {
+    using literals::operator""_b;
+    using literals::operator""_c;
+    using literals::operator""_d;
+    using literals::operator""_f;
+    using literals::operator""_i;
+    using literals::operator""_i16;
+    using literals::operator""_i32;
+    using literals::operator""_i64;
+    using literals::operator""_i8;
+    using literals::operator""_l;
+    using literals::operator""_ld;
+    using literals::operator""_ll;
+    using literals::operator""_s;
+    using literals::operator""_sc;
+    using literals::operator""_u;
+    using literals::operator""_u16;
+    using literals::operator""_u32;
+    using literals::operator""_u64;
+    using literals::operator""_u8;
+    using literals::operator""_uc;
+    using literals::operator""_ul;
+    using literals::operator""_ull;
+    using literals::operator""_us;
+  } // namespace literals
+
+  namespace generators
+  {
+    using generators::boolean;
+    using generators::character;
+    using generators::constant;
+    using generators::element_of;
+    using generators::floating;
+    using generators::integer;
+    using generators::map;
+    using generators::printable;
+    using generators::source;
+    using generators::string;
+    using generators::vector_of;
+  } // namespace generators
+
+  namespace mock
+  {
+    using mock::_;
+    using mock::call;
+    using mock::call_log;
+    using mock::called;
+    using mock::in_order;
+    using mock::method;
+  } // namespace mock
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+  namespace interleavings
+  {
+    using interleavings::atomic;
+    using interleavings::mutex;
+    using interleavings::yield;
+  } // namespace interleavings
+#endif
+
+  namespace utility
+  {
+    using utility::is_match;
+    using utility::split;
+  } // namespace utility
+
+  namespace reflection
+  {
+    using reflection::short_name;
+    using reflection::source_location;
+    using reflection::type_name;
+  } // namespace reflection
+
+  namespace type_traits
+  {
+    using type_traits::floating_point_constant;
+    using type_traits::genuine_integral_value;
+    using type_traits::identity;
+    using type_traits::integral_constant;
+    using type_traits::is_op_v;
+    using type_traits::list;
+    using type_traits::op;
+    using type_traits::value;
+  } // namespace type_traits
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  namespace mock
+  {
+    namespace
+    {
+      std::size_t
+      align_up (std::uintptr_t address, std::size_t alignment)
+      {
+        return detail::integer_cast<std::size_t> (
+            (address + alignment - 1) & ~(std::uintptr_t{ alignment } - 1));
+      }
+    } // namespace
+
+    call_log_base::call_log_base (std::byte* arena, std::size_t size)
+        : arena_{ arena }, size_{ size }
+    {
+    }
+
+    /**
+     * @details
+     * The calls are allocated one after the other, each with the
+     * header followed by the arguments, both aligned; the arena is
+     * never compacted, it is reused only after `clear()`.
+     */
+    void*
+    call_log_base::record (const method_base& method, std::size_t size,
+                           std::size_t alignment)
+    {
+      const std::uintptr_t base = reinterpret_cast<std::uintptr_t> (arena_);
+      const std::size_t header
+          = align_up (base + used_, alignof (call_record)) - base;
+      const std::size_t arguments
+          = align_up (base + header + sizeof (call_record), alignment) - base;
+      if (arguments + size > size_)
+        {
+          ++dropped_;
+          return nullptr;
+        }
+
+      call_record* record = new (arena_ + header)
+          call_record{ &method, nullptr, calls_ };
+      if (last_ != nullptr)
+        {
+          last_->next = record;
+        }
+      else
+        {
+          first_ = record;
+        }
+      last_ = record;
+      used_ = arguments + size;
+      ++calls_;
+
+      return arena_ + arguments;
+    }
+
+    const void*
+    call_log_base::arguments (const call_record& record,
+                              std::size_t alignment)
+    {
+      const std::uintptr_t address
+          = reinterpret_cast<std::uintptr_t> (&record) + sizeof (call_record);
+      return reinterpret_cast<const void*> (align_up (address, alignment));
+    }
+
+    void
+    call_log_base::clear (void)
+    {
+      used_ = 0;
+      calls_ = 0;
+      dropped_ = 0;
+      first_ = nullptr;
+      last_ = nullptr;
+      for (method_base* method = methods_; method != nullptr;
+           method = method->next_)
+        {
+          method->calls_ = 0;
+        }
+    }
+
+    // ========================================================================
+
+    method_base::method_base (call_log_base& log, const char* name)
+        : log_{ log }, name_{ name }
+    {
+      next_ = log.methods_;
+      log.methods_ = this;
+    }
+
+    void
+    method_base::print_calls (test_reporter& reporter, std::size_t max) const
+    {
+      std::size_t count = 0;
+      for (const call_record* record = log_.first (); record != nullptr;
+           record = record->next)
+        {
+          if (record->method != this)
+            {
+              continue;
+            }
+          if (count == max)
+            {
+              reporter << ", ...";
+              return;
+            }
+          reporter << (count == 0 ? "" : ", ") << name_ << ' ';
+          print_arguments (reporter, *record);
+          ++count;
+        }
+    }
+  } // namespace mock
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+// ----------------------------------------------------------------------------
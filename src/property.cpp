@@ -0,0 +1,478 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__APPLE__) || defined(__linux__) || defined(__unix__) \
+    || defined(WIN32)
+#include <chrono>
+#define MICRO_TEST_PLUS_HAS_CLOCK
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  namespace detail
+  {
+    std::uint64_t
+    xoshiro128::splitmix64 (std::uint64_t& state)
+    {
+      std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+
+    xoshiro128::xoshiro128 (std::uint64_t seed)
+    {
+      for (std::size_t i = 0; i < 4; i += 2)
+        {
+          const std::uint64_t z = splitmix64 (seed);
+          state_[i] = static_cast<std::uint32_t> (z);
+          state_[i + 1] = static_cast<std::uint32_t> (z >> 32);
+        }
+    }
+
+    std::uint32_t
+    xoshiro128::next (void)
+    {
+      const std::uint32_t result = std::rotl (state_[1] * 5, 7) * 9;
+      const std::uint32_t t = state_[1] << 9;
+
+      state_[2] ^= state_[0];
+      state_[3] ^= state_[1];
+      state_[1] ^= state_[2];
+      state_[0] ^= state_[3];
+      state_[2] ^= t;
+      state_[3] = std::rotl (state_[3], 11);
+
+      return result;
+    }
+
+    std::uint64_t
+    xoshiro128::next64 (void)
+    {
+      const std::uint64_t high = next ();
+      return (high << 32) | next ();
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+
+  namespace generators
+  {
+    source::source (std::uint64_t seed) : prng_{ seed }
+    {
+    }
+
+    source::source (const std::uint64_t* choices, std::size_t size)
+        : prng_{ 0 }, replay_{ choices }, replay_size_{ size }
+    {
+    }
+
+    /**
+     * @details
+     * Choices between a single value are not recorded. In replay
+     * mode, values larger than `max` are clamped, and running past
+     * the end of the buffer marks the test case as overrun.
+     */
+    std::uint64_t
+    source::draw (std::uint64_t max)
+    {
+      if (max == 0)
+        {
+          return 0;
+        }
+
+      std::uint64_t value = 0;
+      if (replay_ != nullptr)
+        {
+          if (index_ >= replay_size_)
+            {
+              overrun_ = true;
+              return 0;
+            }
+          value = replay_[index_++];
+          if (value > max)
+            {
+              value = max;
+            }
+        }
+      else
+        {
+          if (choices_.size () >= max_choices)
+            {
+              overrun_ = true;
+              return 0;
+            }
+          // Rejection sampling, to avoid the modulo bias.
+          const std::uint64_t mask
+              = ~std::uint64_t{ 0 } >> std::countl_zero (max);
+          do
+            {
+              value = ((max >> 32) != 0) ? prng_.next64 () : prng_.next ();
+              value &= mask;
+            }
+          while (value > max);
+        }
+      choices_.push_back (value);
+      return value;
+    }
+
+    /**
+     * @details
+     * Two or three choices: the sign (only if both signs are
+     * possible), the number of bits of the magnitude and the
+     * magnitude; thus small values are as likely as large ones.
+     */
+    std::int64_t
+    source::draw_integer (std::int64_t min, std::int64_t max)
+    {
+      if (min >= max)
+        {
+          return min;
+        }
+
+      const std::int64_t origin = (min > 0) ? min : (max < 0) ? max : 0;
+      const auto below = static_cast<std::uint64_t> (origin)
+                         - static_cast<std::uint64_t> (min);
+      const auto above = static_cast<std::uint64_t> (max)
+                         - static_cast<std::uint64_t> (origin);
+
+      bool negative = (above == 0);
+      if (below != 0 and above != 0)
+        {
+          negative = (draw (1) != 0);
+        }
+
+      const std::uint64_t span = negative ? below : above;
+      const std::uint64_t bits
+          = draw (detail::integer_cast<std::uint64_t> (std::bit_width (span)));
+      const std::uint64_t limit
+          = (bits >= 64) ? span
+                         : std::min (span, (std::uint64_t{ 1 } << bits) - 1);
+      const std::uint64_t magnitude = draw (limit);
+
+      return static_cast<std::int64_t> (
+          negative ? static_cast<std::uint64_t> (origin) - magnitude
+                   : static_cast<std::uint64_t> (origin) + magnitude);
+    }
+
+    std::uint64_t
+    source::draw_unsigned (std::uint64_t min, std::uint64_t max)
+    {
+      if (min >= max)
+        {
+          return min;
+        }
+
+      const std::uint64_t span = max - min;
+      const std::uint64_t bits
+          = draw (detail::integer_cast<std::uint64_t> (std::bit_width (span)));
+      const std::uint64_t limit
+          = (bits >= 64) ? span
+                         : std::min (span, (std::uint64_t{ 1 } << bits) - 1);
+      return min + draw (limit);
+    }
+
+    /**
+     * @details
+     * The first choice selects the kind: a few values select the
+     * origin or the bounds, all others (including 0) an integer
+     * part and a fraction with 20 bits.
+     */
+    double
+    source::draw_floating (double min, double max)
+    {
+      if (not (min < max))
+        {
+          return min;
+        }
+
+      const double origin = (min > 0) ? min : (max < 0) ? max : 0.0;
+      switch (draw (15))
+        {
+        case 1:
+          return origin;
+        case 2:
+          return min;
+        case 3:
+          return max;
+        default:
+          break;
+        }
+
+      // Integers are exactly representable up to 2^53.
+      constexpr double limit = 9007199254740992.0;
+      const double low = std::ceil (min < -limit ? -limit : min);
+      const double high = std::floor (max > limit ? limit : max);
+
+      constexpr double scale = 1.0 / 1048576.0;
+      const double fraction = static_cast<double> (draw (1048575)) * scale;
+
+      if (low > high)
+        {
+          // No integers in the range.
+          return min + (max - min) * fraction;
+        }
+
+      const double integer = static_cast<double> (draw_integer (
+          static_cast<std::int64_t> (low), static_cast<std::int64_t> (high)));
+      const double value
+          = (integer < 0) ? integer - fraction : integer + fraction;
+      return (value < min or value > max) ? integer : value;
+    }
+  } // namespace generators
+
+  // --------------------------------------------------------------------------
+
+  namespace detail
+  {
+    namespace
+    {
+      // FNV-1a, to derive a stable seed from the property name.
+      std::uint64_t
+      hash (const char* name)
+      {
+        std::uint64_t result = 0xcbf29ce484222325ULL;
+        for (; *name != '\0'; ++name)
+          {
+            result ^= static_cast<unsigned char> (*name);
+            result *= 0x100000001b3ULL;
+          }
+        return result;
+      }
+
+      // Shorter is simpler; at equal length, lexicographically smaller.
+      bool
+      is_simpler (const std::vector<std::uint64_t>& lhs,
+                  const std::vector<std::uint64_t>& rhs)
+      {
+        if (lhs.size () != rhs.size ())
+          {
+            return lhs.size () < rhs.size ();
+          }
+        return lhs < rhs;
+      }
+
+      // An upper limit for properties that are slow to shrink.
+      constexpr std::size_t max_shrink_attempts = 10000;
+    } // namespace
+
+    property_runner::property_runner (const char* name,
+                                      const property_options& options,
+                                      check_function_t check, void* context)
+        : name_{ name }, options_{ options }, check_{ check },
+          context_{ context }
+    {
+    }
+
+    bool
+    property_runner::fails_ (generators::source& source)
+    {
+      const bool holds = check_ (context_, source);
+      return not holds and not source.overrun ();
+    }
+
+    /**
+     * @details
+     * The first test case uses the base seed itself, such that
+     * a failure can be reproduced by passing its seed with
+     * `--seed=N`; the next ones use seeds derived from it.
+     */
+    property_result
+    property_runner::run (void)
+    {
+      std::uint64_t base = runner.seed ();
+      if (base == 0)
+        {
+          base = options_.seed;
+        }
+      if (base == 0)
+        {
+          base = hash (name_);
+        }
+
+      std::size_t iterations = options_.iterations;
+#if defined(MICRO_TEST_PLUS_HAS_CLOCK)
+      using clock = std::chrono::steady_clock;
+      const auto deadline
+          = clock::now () + std::chrono::milliseconds (options_.time_budget_ms);
+      if (iterations == 0 and options_.time_budget_ms == 0)
+#else
+      if (iterations == 0)
+#endif
+        {
+          iterations = 100;
+        }
+
+      for (std::size_t i = 0; iterations == 0 or i < iterations; ++i)
+        {
+#if defined(MICRO_TEST_PLUS_HAS_CLOCK)
+          if (options_.time_budget_ms != 0 and i != 0
+              and clock::now () >= deadline)
+            {
+              break;
+            }
+#endif
+          std::uint64_t seed = base;
+          if (i != 0)
+            {
+              std::uint64_t state = base + i;
+              seed = xoshiro128::splitmix64 (state);
+            }
+
+          generators::source source{ seed };
+          ++result_.tests;
+          if (fails_ (source))
+            {
+              result_.passed = false;
+              result_.seed = seed;
+              result_.choices = std::move (source.choices_);
+              shrink_ ();
+              return result_;
+            }
+        }
+
+      result_.seed = base;
+      return result_;
+    }
+
+    /**
+     * @details
+     * The candidate is accepted if it is simpler than the current
+     * choices and the property still fails; the choices actually
+     * used by the generators (clamped, possibly fewer) are kept.
+     */
+    bool
+    property_runner::try_shrink_ (std::vector<std::uint64_t>& candidate)
+    {
+      if (result_.shrinks >= options_.max_shrinks
+          or attempts_ >= max_shrink_attempts
+          or not is_simpler (candidate, result_.choices))
+        {
+          return false;
+        }
+      ++attempts_;
+
+      generators::source source{ candidate.data (), candidate.size () };
+      if (not fails_ (source))
+        {
+          return false;
+        }
+      source.choices_.resize (source.index_);
+      result_.choices = std::move (source.choices_);
+      ++result_.shrinks;
+      return true;
+    }
+
+    /**
+     * @details
+     * Repeat until no pass makes progress:
+     * - delete blocks of 8, 4, 3, 2 and 1 choices (elements of
+     *   collections, together with their continue flags);
+     * - replace choices by 0;
+     * - binary search smaller values for each choice.
+     */
+    void
+    property_runner::shrink_ (void)
+    {
+      auto& choices = result_.choices;
+      std::vector<std::uint64_t> candidate;
+
+      bool progress = true;
+      while (progress and result_.shrinks < options_.max_shrinks
+             and attempts_ < max_shrink_attempts)
+        {
+          progress = false;
+
+          for (const std::size_t block : { 8u, 4u, 3u, 2u, 1u })
+            {
+              for (std::size_t i = 0; i + block <= choices.size ();)
+                {
+                  candidate = choices;
+                  candidate.erase (
+                      candidate.begin () + static_cast<std::ptrdiff_t> (i),
+                      candidate.begin ()
+                          + static_cast<std::ptrdiff_t> (i + block));
+                  if (try_shrink_ (candidate))
+                    {
+                      progress = true;
+                    }
+                  else
+                    {
+                      ++i;
+                    }
+                }
+            }
+
+          for (std::size_t i = 0; i < choices.size (); ++i)
+            {
+              if (choices[i] == 0)
+                {
+                  continue;
+                }
+              candidate = choices;
+              candidate[i] = 0;
+              if (try_shrink_ (candidate))
+                {
+                  progress = true;
+                  continue;
+                }
+
+              // 0 passes; search the smallest failing value.
+              std::uint64_t low = 0;
+              std::uint64_t high = choices[i];
+              while (low + 1 < high and i < choices.size ())
+                {
+                  const std::uint64_t middle = low + (high - low) / 2;
+                  candidate = choices;
+                  candidate[i] = middle;
+                  if (try_shrink_ (candidate))
+                    {
+                      progress = true;
+                      high = middle;
+                    }
+                  else
+                    {
+                      low = middle;
+                    }
+                }
+            }
+        }
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,185 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from <https://opensource.org/licenses/MIT/>.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus::micro_test_plus
+{
+  // --------------------------------------------------------------------------
+
+  namespace detail
+  {
+    namespace
+    {
+      using clock = std::chrono::steady_clock;
+
+      std::uint64_t
+      elapsed_ns (clock::time_point begin)
+      {
+        return static_cast<std::uint64_t> (
+            std::chrono::duration_cast<std::chrono::nanoseconds> (
+                clock::now () - begin)
+                .count ());
+      }
+
+      /**
+       * @brief Pin each thread to a different processor, if the
+       * process may use enough of them; otherwise leave them
+       * to the scheduler.
+       */
+      void
+      pin_threads ([[maybe_unused]] std::vector<std::thread>& threads)
+      {
+#if defined(__linux__)
+        cpu_set_t allowed;
+        CPU_ZERO (&allowed);
+        if (sched_getaffinity (0, sizeof (allowed), &allowed) != 0
+            || static_cast<std::size_t> (CPU_COUNT (&allowed))
+                   < threads.size ())
+          {
+            return;
+          }
+
+        std::size_t cpu = 0;
+        for (auto& thread : threads)
+          {
+            while (not CPU_ISSET (cpu, &allowed))
+              {
+                ++cpu;
+              }
+            cpu_set_t set;
+            CPU_ZERO (&set);
+            CPU_SET (cpu, &set);
+            pthread_setaffinity_np (thread.native_handle (), sizeof (set),
+                                    &set);
+            ++cpu;
+          }
+#endif
+      }
+    } // namespace
+
+    /**
+     * @details
+     * The threads announce that they are ready, then spin until
+     * the start flag is set, yielding from time to time in case
+     * there are more threads than processors.
+     *
+     * The total duration is measured by the calling thread, from
+     * the start until all threads are joined; each thread measures
+     * its own duration.
+     */
+    stress_
+    run_stress (std::size_t threads, std::size_t iterations,
+                stress_function_t function, void* callable)
+    {
+      if (threads == 0)
+        {
+          threads = 1;
+        }
+
+      std::vector<stress_thread_> results (threads, stress_thread_{ 0, 0 });
+      std::atomic<std::size_t> ready{ 0 };
+      std::atomic<bool> start{ false };
+
+      const std::size_t failed_checks_before = worker_failed_checks ();
+
+      std::vector<std::thread> workers;
+      workers.reserve (threads);
+      for (std::size_t t = 0; t < threads; ++t)
+        {
+          workers.emplace_back ([&, t] {
+            ready.fetch_add (1, std::memory_order_release);
+            for (unsigned int spins = 1;
+                 not start.load (std::memory_order_acquire); ++spins)
+              {
+                if (spins % 1024 == 0)
+                  {
+                    std::this_thread::yield ();
+                  }
+              }
+
+            const clock::time_point begin = clock::now ();
+            std::size_t failures = 0;
+            for (std::size_t i = 0; i < iterations; ++i)
+              {
+                if (not function (callable, t, i))
+                  {
+                    ++failures;
+                  }
+              }
+            results[t] = { failures, elapsed_ns (begin) };
+          });
+        }
+
+      pin_threads (workers);
+
+      while (ready.load (std::memory_order_acquire) < threads)
+        {
+          std::this_thread::yield ();
+        }
+
+      const clock::time_point begin = clock::now ();
+      start.store (true, std::memory_order_release);
+
+      for (auto& worker : workers)
+        {
+          worker.join ();
+        }
+      const std::uint64_t elapsed = elapsed_ns (begin);
+
+      const std::size_t failed_checks
+          = worker_failed_checks () - failed_checks_before;
+      bool value = (failed_checks == 0);
+      for (const auto& result : results)
+        {
+          value = value && (result.failures == 0);
+        }
+
+      return stress_{
+        {}, value, iterations, failed_checks, elapsed, std::move (results)
+      };
+    }
+  } // namespace detail
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::micro_test_plus
+
+#endif // defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
+// ----------------------------------------------------------------------------
@@ -37,15 +37,26 @@ namespace micro_os_plus::micro_test_plus
   test_reporter&
   endl (test_reporter& stream)
   {
-    reporter.endline ();
+    stream.endline ();
     return stream;
   }
 
   // --------------------------------------------------------------------------
 
-  void
+  /**
+   * @details
+   * The passed checks are displayed in verbose mode, and in normal
+   * mode with the test cases that fail; in the other cases they
+   * are only counted, without formatting the expressions.
+   */
+  bool
   test_reporter::output_pass_prefix_ (std::string& message)
   {
+    if (not displays_passes ())
+      {
+        return false;
+      }
+
     *this << colors_.pass;
     if (is_in_test_case_)
       {
@@ -57,6 +68,7 @@ namespace micro_os_plus::micro_test_plus
       {
         *this << message.c_str ();
       }
+    return true;
   }
 
   void
@@ -111,6 +123,694 @@ namespace micro_os_plus::micro_test_plus
     flush ();
   }
 
+  void
+  test_reporter::output_range_mismatch_ (std::size_t index,
+                                         std::size_t lhs_size,
+                                         std::size_t rhs_size)
+  {
+    // Indices and sizes are displayed without the type suffix.
+    if (lhs_size != rhs_size)
+      {
+        out_.append (" (sizes differ, ");
+        out_.append (std::to_string (lhs_size));
+        out_.append (" vs. ");
+        out_.append (std::to_string (rhs_size));
+        if (index < lhs_size && index < rhs_size)
+          {
+            out_.append (", first difference at index ");
+            out_.append (std::to_string (index));
+          }
+      }
+    else
+      {
+        out_.append (" (first difference at index ");
+        out_.append (std::to_string (index));
+        out_.append (" of ");
+        out_.append (std::to_string (lhs_size));
+      }
+    out_.append (")");
+  }
+
+  test_reporter&
+  test_reporter::operator<< (const detail::eq_bytes_& op)
+  {
+    out_.append (color (op));
+    out_.append ("bytes[");
+    out_.append (std::to_string (op.size ()));
+    out_.append ("] == bytes[");
+    out_.append (std::to_string (op.size ()));
+    out_.append ("]");
+    out_.append (colors_.none);
+    if (not op)
+      {
+        char buf[64];
+        snprintf (buf, sizeof (buf), " (first difference at offset 0x%zx)",
+                  op.mismatch ());
+        out_.append (buf);
+      }
+    return *this;
+  }
+
+  test_reporter&
+  test_reporter::operator<< (const detail::filled_with_& op)
+  {
+    char buf[64];
+    out_.append (color (op));
+    out_.append ("bytes[");
+    out_.append (std::to_string (op.size ()));
+    snprintf (buf, sizeof (buf), "] filled with 0x%02x", op.pattern ());
+    out_.append (buf);
+    out_.append (colors_.none);
+    if (not op)
+      {
+        snprintf (buf, sizeof (buf), " (first difference at offset 0x%zx)",
+                  op.mismatch ());
+        out_.append (buf);
+      }
+    return *this;
+  }
+
+  test_reporter&
+  test_reporter::operator<< (const detail::all_close_& op)
+  {
+    char buf[160];
+    out_.append (color (op));
+    snprintf (buf, sizeof (buf), "%s[%zu] close to %s[%zu] (rel %g, abs %g",
+              op.type_name (), op.lhs_size (), op.type_name (),
+              op.rhs_size (), op.rel_tol (), op.abs_tol ());
+    out_.append (buf);
+    if (op.max_ulps () != 0)
+      {
+        snprintf (buf, sizeof (buf), ", %llu ulps",
+                  static_cast<unsigned long long> (op.max_ulps ()));
+        out_.append (buf);
+      }
+    out_.append (")");
+    out_.append (colors_.none);
+
+    if (not op)
+      {
+        const auto& result = op.result ();
+        if (op.lhs_size () != op.rhs_size ())
+          {
+            out_.append (" (sizes differ");
+          }
+        else
+          {
+            out_.append (" (");
+            out_.append (std::to_string (result.violations));
+            out_.append (" of ");
+            out_.append (std::to_string (op.lhs_size ()));
+            out_.append (" not close");
+          }
+        if (result.violations != 0)
+          {
+            snprintf (buf, sizeof (buf),
+                      ", worst at index %zu: %g vs. %g, error %g",
+                      result.worst_index,
+                      result.worst_lhs, result.worst_rhs,
+                      result.worst_error);
+            out_.append (buf);
+          }
+        out_.append (")");
+      }
+    return *this;
+  }
+
+  test_reporter&
+  test_reporter::operator<< (const detail::property_& op)
+  {
+    out_.append (color (op));
+    if (op)
+      {
+        out_.append ("property holds for ");
+        out_.append (std::to_string (op.tests_));
+        out_.append (op.tests_ == 1 ? " test" : " tests");
+        out_.append (colors_.none);
+        return *this;
+      }
+
+    out_.append ("falsified by ");
+    if (op.print_ != nullptr)
+      {
+        op.print_ (*this, op.values_);
+      }
+    out_.append (" after ");
+    out_.append (std::to_string (op.tests_));
+    out_.append (op.tests_ == 1 ? " test and " : " tests and ");
+    out_.append (std::to_string (op.shrinks_));
+    out_.append (op.shrinks_ == 1 ? " shrink, seed " : " shrinks, seed ");
+    out_.append (std::to_string (op.seed_));
+    out_.append (" (--seed=");
+    out_.append (std::to_string (op.seed_));
+    out_.append (" to reproduce)");
+    out_.append (colors_.none);
+    return *this;
+  }
+
+  /**
+   * @details
+   * The durations are displayed in milliseconds, and the
+   * throughput of each thread in iterations per second.
+   */
+  test_reporter&
+  test_reporter::operator<< (const detail::stress_& op)
+  {
+    const auto append_ms = [this] (std::uint64_t ns) {
+      char buf[32];
+      snprintf (buf, sizeof (buf), "%llu.%03llu ms",
+                static_cast<unsigned long long> (ns / 1000000),
+                static_cast<unsigned long long> (ns / 1000 % 1000));
+      out_.append (buf);
+    };
+
+    out_.append (color (op));
+    if (not op)
+      {
+        std::size_t failures = 0;
+        for (const auto& thread : op.threads_)
+          {
+            failures += thread.failures;
+          }
+        if (failures > 0)
+          {
+            out_.append (std::to_string (failures));
+            out_.append (" of ");
+            out_.append (
+                std::to_string (op.iterations_ * op.threads_.size ()));
+            out_.append (" iterations failed (");
+            bool first = true;
+            for (std::size_t i = 0; i < op.threads_.size (); ++i)
+              {
+                if (op.threads_[i].failures == 0)
+                  {
+                    continue;
+                  }
+                out_.append (first ? "thread " : ", thread ");
+                out_.append (std::to_string (i));
+                out_.append (": ");
+                out_.append (std::to_string (op.threads_[i].failures));
+                first = false;
+              }
+            out_.append ("), ");
+          }
+        if (op.failed_checks_ > 0)
+          {
+            out_.append (std::to_string (op.failed_checks_));
+            out_.append (op.failed_checks_ == 1 ? " failed check"
+                                                : " failed checks");
+            out_.append (" in threads, ");
+          }
+      }
+
+    out_.append (std::to_string (op.threads_.size ()));
+    out_.append (op.threads_.size () == 1 ? " thread x " : " threads x ");
+    out_.append (std::to_string (op.iterations_));
+    out_.append (op.iterations_ == 1 ? " iteration in " : " iterations in ");
+    append_ms (op.elapsed_ns_);
+    out_.append ("; per thread:");
+    for (std::size_t i = 0; i < op.threads_.size (); ++i)
+      {
+        const std::uint64_t ns = op.threads_[i].elapsed_ns;
+        out_.append (i == 0 ? " " : ", ");
+        out_.append (std::to_string (
+            ns == 0 ? 0
+                    : static_cast<std::uint64_t> (
+                          static_cast<double> (op.iterations_) * 1e9
+                          / static_cast<double> (ns))));
+      }
+    out_.append (" iterations/s");
+    out_.append (colors_.none);
+    return *this;
+  }
+
+  /**
+   * @details
+   * For failures, the schedule is displayed such that it can be
+   * copied to `explore_options::schedule`.
+   */
+  test_reporter&
+  test_reporter::operator<< (const detail::explore_& op)
+  {
+    using failure = detail::explore_::failure;
+
+    out_.append (color (op));
+    if (op)
+      {
+        if (op.replay_)
+          {
+            out_.append ("replayed schedule");
+          }
+        else
+          {
+            out_.append (std::to_string (op.schedules_));
+            out_.append (op.random_ ? " random schedule" : " schedule");
+            out_.append (op.schedules_ == 1 ? "" : "s");
+          }
+        out_.append (" passed, with ");
+        out_.append (std::to_string (op.threads_));
+        out_.append (op.threads_ == 1 ? " thread" : " threads");
+        out_.append (" and at most ");
+        out_.append (std::to_string (op.preemption_bound_));
+        out_.append (op.preemption_bound_ == 1 ? " preemption"
+                                               : " preemptions");
+        if (not op.exhausted_ && not op.random_ && not op.replay_)
+          {
+            out_.append (" (not all explored)");
+          }
+        out_.append (colors_.none);
+        return *this;
+      }
+
+    switch (op.failure_)
+      {
+      case failure::body:
+        out_.append ("thread body failed");
+        break;
+      case failure::checks:
+        out_.append (std::to_string (op.failed_checks_));
+        out_.append (op.failed_checks_ == 1 ? " failed check"
+                                            : " failed checks");
+        out_.append (" in threads");
+        break;
+      case failure::check:
+        out_.append ("final check failed");
+        break;
+      case failure::deadlock:
+        out_.append ("deadlock");
+        break;
+      case failure::steps:
+        out_.append ("too many steps");
+        break;
+      case failure::none:
+        // Passed, displayed above.
+        break;
+      }
+    if (op.replay_)
+      {
+        out_.append (" in the replayed schedule");
+      }
+    else
+      {
+        out_.append (" in schedule ");
+        out_.append (std::to_string (op.schedules_));
+        if (op.max_schedules_ != 0)
+          {
+            out_.append (op.random_ ? " of " : " of at most ");
+            out_.append (std::to_string (op.max_schedules_));
+          }
+      }
+    out_.append (", with ");
+    out_.append (std::to_string (op.threads_));
+    out_.append (op.threads_ == 1 ? " thread" : " threads");
+    out_.append (" and ");
+    out_.append (std::to_string (op.preemptions_));
+    out_.append (op.preemptions_ == 1 ? " preemption" : " preemptions");
+    out_.append (" (schedule \"");
+    out_.append (op.schedule_);
+    out_.append ("\" to replay)");
+    out_.append (colors_.none);
+    return *this;
+  }
+
+  /**
+   * @details
+   * For failures, the operation which could not be ordered after
+   * the longest valid sequence is displayed, with its result.
+   */
+  test_reporter&
+  test_reporter::operator<< (const detail::linearizable_& op)
+  {
+    out_.append (color (op));
+    if (op)
+      {
+        out_.append ("linearizable, ");
+      }
+    else if (op.dropped_ > 0)
+      {
+        out_.append ("history full, ");
+        out_.append (std::to_string (op.dropped_));
+        out_.append (op.dropped_ == 1 ? " operation" : " operations");
+        out_.append (" not recorded, ");
+      }
+    else if (op.gave_up_)
+      {
+        out_.append ("gave up after ");
+        out_.append (std::to_string (op.states_));
+        out_.append (op.states_ == 1 ? " state, " : " states, ");
+      }
+    else
+      {
+        out_.append ("not linearizable, ");
+        if (op.operation_ != nullptr)
+          {
+            out_.append ("no valid order for ");
+            op.print_operation_ (*this, op.operation_);
+            out_.append (" -> ");
+            op.print_result_ (*this, op.result_);
+            out_.append (" by thread ");
+            out_.append (std::to_string (op.thread_));
+            out_.append (", ");
+          }
+        out_.append ("at most ");
+        out_.append (std::to_string (op.longest_));
+        out_.append (" of ");
+      }
+
+    out_.append (std::to_string (op.operations_));
+    out_.append (op.operations_ == 1 ? " operation" : " operations");
+    if (op.pending_ > 0)
+      {
+        out_.append (" (");
+        out_.append (std::to_string (op.pending_));
+        out_.append (" pending)");
+      }
+    if (not op.gave_up_)
+      {
+        out_.append (", ");
+        out_.append (std::to_string (op.states_));
+        out_.append (op.states_ == 1 ? " state" : " states");
+      }
+    out_.append (colors_.none);
+    return *this;
+  }
+
+  /**
+   * @details
+   * For failures, the recorded calls of the method are displayed.
+   */
+  test_reporter&
+  test_reporter::operator<< (const detail::mock_called_& op)
+  {
+    out_.append (color (op));
+    out_.append (op.method_->name ());
+    out_.append (" called ");
+    out_.append (std::to_string (op.actual_));
+    out_.append (op.actual_ == 1 ? " time" : " times");
+    if (op.matched_)
+      {
+        out_.append (" with matching arguments");
+      }
+    if (not op)
+      {
+        out_.append (", expected ");
+        out_.append (std::to_string (op.expected_));
+        if (op.dropped_ > 0)
+          {
+            out_.append (", ");
+            out_.append (std::to_string (op.dropped_));
+            out_.append (op.dropped_ == 1 ? " call" : " calls");
+            out_.append (" not recorded (call log full)");
+          }
+        if (op.method_->calls () > 0)
+          {
+            out_.append ("; calls: ");
+            op.method_->print_calls (*this, 8);
+          }
+      }
+    out_.append (colors_.none);
+    return *this;
+  }
+
+  test_reporter&
+  test_reporter::operator<< (const detail::mock_in_order_& op)
+  {
+    out_.append (color (op));
+    if (op)
+      {
+        out_.append (std::to_string (op.calls_));
+        out_.append (op.calls_ == 1 ? " call in order" : " calls in order");
+      }
+    else
+      {
+        out_.append ("call ");
+        out_.append (std::to_string (op.missing_ + 1));
+        out_.append (" of ");
+        out_.append (std::to_string (op.calls_));
+        out_.append (" (");
+        out_.append (op.method_->name ());
+        out_.append (") not found in order");
+        if (op.dropped_ > 0)
+          {
+            out_.append (", ");
+            out_.append (std::to_string (op.dropped_));
+            out_.append (op.dropped_ == 1 ? " call" : " calls");
+            out_.append (" not recorded (call log full)");
+          }
+      }
+    out_.append (colors_.none);
+    return *this;
+  }
+
+  test_reporter&
+  test_reporter::operator<< (const detail::table_row_& op)
+  {
+    out_.append (color (op));
+    if (op)
+      {
+        out_.append (std::to_string (op.rows_));
+        out_.append (" rows");
+        out_.append (colors_.none);
+        return *this;
+      }
+
+    out_.append ("row ");
+    out_.append (std::to_string (op.index_));
+    out_.append (" ");
+    op.print_row_ (*this, op.row_);
+    if (op.print_result_ != nullptr)
+      {
+        out_.append (": ");
+        op.print_result_ (*this, op.result_);
+      }
+    out_.append (colors_.none);
+    return *this;
+  }
+
+  /**
+   * @details
+   * All erased expressions are displayed by this function, thus
+   * the lite mode does not instantiate the output operators
+   * for each expression.
+   *
+   * Nested expressions are displayed only as their results.
+   */
+  test_reporter&
+  test_reporter::operator<< (const detail::lite_expression& expr)
+  {
+    using detail::lite_op;
+
+    switch (expr.op_)
+      {
+      case lite_op::and_:
+      case lite_op::or_:
+        *this << '(';
+        output_lite_operand_ (expr.lhs_);
+        *this << color (expr) << (expr.op_ == lite_op::and_ ? " and " : " or ")
+              << colors_.none;
+        output_lite_operand_ (expr.rhs_);
+        *this << ')';
+        break;
+
+      case lite_op::not_:
+        *this << color (expr) << "not ";
+        output_lite_operand_ (expr.lhs_);
+        *this << colors_.none;
+        break;
+
+      case lite_op::throws:
+        *this << color (expr) << "throws";
+        if (expr.lhs_.kind_ == detail::lite_operand::kind::string)
+          {
+            *this << '<';
+            output_lite_operand_ (expr.lhs_);
+            *this << '>';
+          }
+        *this << colors_.none;
+        break;
+
+      case lite_op::nothrow:
+        *this << color (expr) << "nothrow" << colors_.none;
+        break;
+
+      case lite_op::none:
+      case lite_op::eq:
+      case lite_op::ne:
+      case lite_op::lt:
+      case lite_op::le:
+      case lite_op::gt:
+      case lite_op::ge:
+        {
+          static constexpr const char* symbols[] = {
+            "", " == ", " != ", " < ", " <= ", " > ", " >= ",
+          };
+          const auto index = static_cast<std::size_t> (expr.op_);
+          *this << color (expr);
+          output_lite_operand_ (expr.lhs_);
+          *this << (index < sizeof (symbols) / sizeof (symbols[0])
+                        ? symbols[index]
+                        : " ? ");
+          output_lite_operand_ (expr.rhs_);
+          *this << colors_.none;
+        }
+        break;
+      }
+    return *this;
+  }
+
+  void
+  test_reporter::output_lite_operand_ (const detail::lite_operand& operand)
+  {
+    using kind = detail::lite_operand::kind;
+
+    switch (operand.kind_)
+      {
+      case kind::boolean:
+        *this << (operand.value_.unsigned_integer != 0);
+        break;
+
+      case kind::character:
+        *this << static_cast<char> (operand.value_.signed_integer);
+        break;
+
+      case kind::signed_integer:
+        out_.append (std::to_string (operand.value_.signed_integer));
+        break;
+
+      case kind::unsigned_integer:
+        out_.append (std::to_string (operand.value_.unsigned_integer));
+        break;
+
+      case kind::floating_point:
+        *this << operand.value_.floating_point;
+        break;
+
+      case kind::pointer:
+        if (operand.value_.pointer == nullptr)
+          {
+            out_.append ("nullptr");
+          }
+        else
+          {
+            char buff[20];
+            snprintf (buff, sizeof (buff), "%p", operand.value_.pointer);
+            out_.append (buff);
+          }
+        break;
+
+      case kind::string:
+        out_.append (operand.value_.string, operand.length_);
+        break;
+
+      case kind::none:
+      case kind::opaque:
+        out_.append ("{...}");
+        break;
+      }
+  }
+
+  void
+  test_reporter::output_fail_details_ (const detail::eq_bytes_& op)
+  {
+    output_hex_dump_ (op.lhs (), op.rhs (), 0, op.size (), op.mismatch (),
+                      op.max_rows);
+  }
+
+  void
+  test_reporter::output_fail_details_ (const detail::filled_with_& op)
+  {
+    output_hex_dump_ (op.data (), nullptr, op.pattern (), op.size (),
+                      op.mismatch (), op.max_rows);
+  }
+
+  /**
+   * @details
+   * Display the actual and the expected bytes, side by side,
+   * only for the 16 bytes rows that differ, starting with the row
+   * of the given offset; the expected bytes are either the `rhs`
+   * array or, if null, the `pattern`.
+   *
+   * The rows that exceed `max_rows` are only counted.
+   */
+  void
+  test_reporter::output_hex_dump_ (const std::uint8_t* lhs,
+                                   const std::uint8_t* rhs,
+                                   std::uint8_t pattern, std::size_t size,
+                                   std::size_t offset, std::size_t max_rows)
+  {
+    constexpr std::size_t row_size = 16;
+    std::size_t rows = 0;
+    char buf[24];
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+    while (offset < size)
+      {
+        const std::size_t row = offset - offset % row_size;
+        const std::size_t end
+            = (size - row > row_size) ? row + row_size : size;
+
+        if (rows < max_rows)
+          {
+            out_.append (is_in_test_case_ ? "      " : "    ");
+            snprintf (buf, sizeof (buf), "%08zx:", row);
+            out_.append (buf);
+            for (int side = 0; side < 2; ++side)
+              {
+                if (side != 0)
+                  {
+                    out_.append (" |");
+                  }
+                // Pad only the left side of a partial last row.
+                const std::size_t last = (side == 0) ? row + row_size : end;
+                for (std::size_t i = row; i < last; ++i)
+                  {
+                    if (i >= end)
+                      {
+                        out_.append ("   ");
+                        continue;
+                      }
+                    out_.append (" ");
+                    const std::uint8_t expected
+                        = (rhs != nullptr) ? rhs[i] : pattern;
+                    snprintf (buf, sizeof (buf), "%02x",
+                              (side == 0) ? lhs[i] : expected);
+                    if (lhs[i] != expected)
+                      {
+                        out_.append (colors_.fail);
+                        out_.append (buf);
+                        out_.append (colors_.none);
+                      }
+                    else
+                      {
+                        out_.append (buf);
+                      }
+                  }
+              }
+            out_.append ("\n");
+          }
+        ++rows;
+
+        // Skip the identical rows with the fast search.
+        offset = end
+                 + ((rhs != nullptr) ? detail::mismatch_offset (
+                        lhs + end, rhs + end, size - end)
+                                     : detail::fill_mismatch_offset (
+                                         lhs + end, pattern, size - end));
+      }
+#pragma GCC diagnostic pop
+
+    if (rows > max_rows)
+      {
+        out_.append (is_in_test_case_ ? "      " : "    ");
+        out_.append ("... ");
+        out_.append (std::to_string (rows - max_rows));
+        out_.append (" more different rows\n");
+      }
+  }
+
   test_reporter&
   test_reporter::operator<< (test_reporter& (*func) (test_reporter&))
   {
@@ -280,6 +980,7 @@ namespace micro_os_plus::micro_test_plus
   test_reporter::begin_test_case ([[maybe_unused]] const char* name)
   {
     is_in_test_case_ = true;
+    last_pass = {};
 
     if (!out_.empty () && (verbosity == verbosity::verbose))
       {
@@ -363,6 +1064,80 @@ namespace micro_os_plus::micro_test_plus
     is_in_test_case_ = false;
   }
 
+  void
+  test_reporter::output_coverage (
+      const char* name, const detail::combinations_coverage& coverage)
+  {
+    if (verbosity == verbosity::normal || verbosity == verbosity::verbose)
+      {
+        const char* tuples = "pairs";
+        char buf[32];
+        if (coverage.strength == 1)
+          {
+            tuples = "values";
+          }
+        else if (coverage.strength == 3)
+          {
+            tuples = "triples";
+          }
+        else if (coverage.strength > 3)
+          {
+            snprintf (buf, sizeof (buf), "%zu-tuples", coverage.strength);
+            tuples = buf;
+          }
+
+        flush ();
+        printf ("\n  • %s - %zu of %zu combinations, covering %zu of %zu "
+                "%s (%zu%%)\n",
+                name, coverage.cases, coverage.product, coverage.covered,
+                coverage.tuples, tuples,
+                coverage.tuples == 0
+                    ? static_cast<std::size_t> (100)
+                    : coverage.covered * 100 / coverage.tuples);
+        add_empty_line = false;
+      }
+  }
+
+  /**
+   * @details
+   * Called from the watchdog thread. The test case is usually
+   * blocked, but it may also be still running and appending to the
+   * buffer, or updating the last passed check, which are read
+   * without a lock (a lock for each check would slow down all
+   * tests); the output may then be incomplete or inconsistent.
+   */
+  void
+  test_reporter::output_timeout (std::uint32_t timeout_ms)
+  {
+    if (verbosity == verbosity::silent)
+      {
+        return;
+      }
+
+    flush ();
+    printf ("\n  • %s - test case started\n",
+            current_test_suite->test_case_name ());
+    output ();
+    printf ("  %s✗%s %s - test case %sTIMEOUT%s after %u ms, in test suite "
+            "'%s'",
+            colors_.fail, colors_.none, current_test_suite->test_case_name (),
+            colors_.fail, colors_.none,
+            detail::integer_cast<unsigned int> (timeout_ms),
+            current_test_suite->name ());
+    if (last_pass.line () != 0)
+      {
+        printf (", last passed check at %s:%u",
+                reflection::short_name (last_pass.file_name ()),
+                static_cast<unsigned int> (last_pass.line ()));
+      }
+    else
+      {
+        printf (", no passed checks");
+      }
+    printf ("\n");
+    fflush (stdout);
+  }
+
   void
   test_reporter::begin_test_suite (const char* name)
   {
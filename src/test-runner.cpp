@@ -23,11 +23,26 @@
 #include <micro-os-plus/micro-test-plus.h>
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
 #include <vector>
 
+#if (defined(__APPLE__) || defined(__linux__) || defined(__unix__) \
+     || defined(WIN32))                                              \
+    && !defined(MICRO_TEST_PLUS_NO_WATCHDOG)                        \
+    && !defined(MICRO_TEST_PLUS_NO_THREADS)
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#define MICRO_TEST_PLUS_HAS_WATCHDOG
+#endif
+
 // ----------------------------------------------------------------------------
 
 #pragma GCC diagnostic ignored "-Waggregate-return"
+#pragma GCC diagnostic ignored "-Wpadded"
 #if defined(__clang__)
 #pragma clang diagnostic ignored "-Wc++98-compat"
 #pragma clang diagnostic ignored "-Wc++98-c++11-c++14-compat"
@@ -38,6 +53,104 @@ namespace micro_os_plus::micro_test_plus
 {
   // --------------------------------------------------------------------------
 
+#if defined(MICRO_TEST_PLUS_HAS_WATCHDOG)
+  namespace detail
+  {
+    /**
+     * @brief A thread that terminates the process if a test case
+     * runs longer than the timeout.
+     *
+     * @details
+     * The process exits with code 124 (like the `timeout` command),
+     * after displaying the buffered output and the test case name.
+     */
+    class watchdog
+    {
+    public:
+      explicit watchdog (std::uint32_t timeout_ms)
+          : timeout_{ timeout_ms }, thread_{ [this] { run_ (); } }
+      {
+      }
+
+      watchdog (const watchdog&) = delete;
+      watchdog (watchdog&&) = delete;
+      watchdog&
+      operator= (const watchdog&)
+          = delete;
+      watchdog&
+      operator= (watchdog&&)
+          = delete;
+
+      ~watchdog ()
+      {
+        {
+          std::lock_guard<std::mutex> lock{ mutex_ };
+          stop_ = true;
+        }
+        condition_.notify_one ();
+        thread_.join ();
+      }
+
+      void
+      arm (void)
+      {
+        {
+          std::lock_guard<std::mutex> lock{ mutex_ };
+          deadline_ = clock::now () + timeout_;
+          armed_ = true;
+        }
+        condition_.notify_one ();
+      }
+
+      void
+      disarm (void)
+      {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        armed_ = false;
+      }
+
+    protected:
+      using clock = std::chrono::steady_clock;
+
+      void
+      run_ (void)
+      {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        while (not stop_)
+          {
+            if (not armed_)
+              {
+                condition_.wait (lock);
+              }
+            else if (condition_.wait_until (lock, deadline_)
+                         == std::cv_status::timeout
+                     and armed_ and clock::now () >= deadline_)
+              {
+                reporter.output_timeout (
+                    static_cast<std::uint32_t> (timeout_.count ()));
+                // The test case cannot end meanwhile, since disarm()
+                // waits for the mutex; but it may still run, and the
+                // reporter buffer is read without a lock.
+                runner.record_interrupted_test_case ();
+                std::_Exit (124);
+              }
+          }
+      }
+
+      const std::chrono::milliseconds timeout_;
+      std::mutex mutex_{};
+      std::condition_variable condition_{};
+      clock::time_point deadline_{};
+      bool armed_ = false;
+      bool stop_ = false;
+      // Last, to be started after all other members are constructed.
+      std::thread thread_;
+    };
+  } // namespace detail
+#endif // defined(MICRO_TEST_PLUS_HAS_WATCHDOG)
+
+  // --------------------------------------------------------------------------
+
   test_runner::test_runner ()
   {
 #if defined(MICRO_TEST_PLUS_TRACE)
@@ -59,6 +172,10 @@ namespace micro_os_plus::micro_test_plus
     argc_ = argc;
     argv_ = argv;
 
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+    detail::in_runner_thread = true;
+#endif
+
     default_suite_name_ = name;
 
 #if !(defined(MICRO_OS_PLUS_INCLUDE_STARTUP) && defined(MICRO_OS_PLUS_TRACE))
@@ -77,6 +194,8 @@ namespace micro_os_plus::micro_test_plus
 #endif // !defined(MICRO_OS_PLUS_INCLUDE_STARTUP)
 
     verbosity_t verbosity = verbosity::normal;
+    bool list = false;
+    bool repeat_given = false;
     for (int i = 0; i < argc; ++i)
       {
         if (strcmp (argv[i], "--verbose") == 0)
@@ -91,11 +210,84 @@ namespace micro_os_plus::micro_test_plus
           {
             verbosity = verbosity::silent;
           }
+        else if (strncmp (argv[i], "--seed=", 7) == 0)
+          {
+            seed_ = strtoull (argv[i] + 7, nullptr, 0);
+          }
+        else if (strcmp (argv[i], "--rerun-failed") == 0)
+          {
+            rerun_failed_ = true;
+          }
+        else if (strncmp (argv[i], "--state-file=", 13) == 0)
+          {
+            state_file_ = argv[i] + 13;
+          }
+        else if (strncmp (argv[i], "--timeout=", 10) == 0)
+          {
+            // In seconds, possibly with decimals.
+            timeout_ms_ = static_cast<std::uint32_t> (
+                strtod (argv[i] + 10, nullptr) * 1000);
+          }
+        else if (strcmp (argv[i], "--fail-fast") == 0)
+          {
+            max_failures_ = 1;
+          }
+        else if (strncmp (argv[i], "--max-failures=", 15) == 0)
+          {
+            max_failures_ = atoi (argv[i] + 15);
+          }
+        else if (strncmp (argv[i], "--repeat=", 9) == 0)
+          {
+            repeat_ = atoi (argv[i] + 9);
+            repeat_given = true;
+          }
+        else if (strcmp (argv[i], "--until-fail") == 0)
+          {
+            until_fail_ = true;
+          }
+        else if (strcmp (argv[i], "--list") == 0)
+          {
+            list = true;
+          }
+        else if (strncmp (argv[i], "--filter=", 9) == 0)
+          {
+            filter_ = argv[i] + 9;
+          }
+        else if (strncmp (argv[i], "--tag=", 6) == 0)
+          {
+            tag_ = argv[i] + 6;
+          }
+      }
+
+    if (until_fail_ && not repeat_given)
+      {
+        // Until the first failure, with no limit.
+        repeat_ = 0;
+      }
+    else if (repeat_ < 1)
+      {
+        repeat_ = 1;
+      }
+
+    if (list)
+      {
+        // Nothing is executed, not even the test cases in main().
+        list_test_cases_ ();
+        exit (0);
       }
 
     // Pass the verbosity to the reporter.
     reporter.verbosity = verbosity;
 
+#if defined(__APPLE__) || defined(__linux__) || defined(__unix__) \
+    || defined(WIN32)
+    if (state_file_.empty () && argc > 0)
+      {
+        state_file_ = argv[0];
+        state_file_.append (".state");
+      }
+#endif
+
     // ------------------------------------------------------------------------
 
 #if !(defined(MICRO_OS_PLUS_INCLUDE_STARTUP) && defined(MICRO_OS_PLUS_TRACE))
@@ -134,6 +326,18 @@ namespace micro_os_plus::micro_test_plus
 
     // ------------------------------------------------------------------------
 
+    if (rerun_failed_)
+      {
+        read_state_ ();
+      }
+
+#if defined(MICRO_TEST_PLUS_HAS_WATCHDOG)
+    if (timeout_ms_ != 0)
+      {
+        watchdog_ = new detail::watchdog (timeout_ms_);
+      }
+#endif
+
     default_test_suite_ = new test_suite_base (default_suite_name_);
     current_test_suite = default_test_suite_;
 
@@ -148,6 +352,68 @@ namespace micro_os_plus::micro_test_plus
   {
     bool was_successful = true;
 
+    int iteration = 1;
+    for (;; ++iteration)
+      {
+        if (iteration > 1)
+          {
+            if (reporter.verbosity == verbosity::normal
+                || reporter.verbosity == verbosity::verbose)
+              {
+                if (repeat_ > 0)
+                  {
+                    printf ("\nIteration %d of %d.\n", iteration, repeat_);
+                  }
+                else
+                  {
+                    printf ("\nIteration %d.\n", iteration);
+                  }
+              }
+            // Only the registered test cases are executed again
+            // in the default test suite.
+            default_test_suite_->reset_counters ();
+          }
+
+        const bool iteration_successful = run_iteration_ ();
+        was_successful &= iteration_successful;
+
+        if (stopped () || (until_fail_ && not iteration_successful)
+            || (repeat_ > 0 && iteration >= repeat_))
+          {
+            break;
+          }
+      }
+
+    if (iteration > 1)
+      {
+        output_statistics_ (iteration);
+      }
+
+#if defined(MICRO_TEST_PLUS_HAS_WATCHDOG)
+    delete watchdog_;
+    watchdog_ = nullptr;
+#endif
+
+    if (stopped () && reporter.verbosity != verbosity::silent)
+      {
+        printf ("\nStopped after %d failed test case%s, the other test "
+                "cases were not executed.\n",
+                failed_test_cases_, failed_test_cases_ == 1 ? "" : "s");
+      }
+
+    write_state_ (not stopped ());
+
+    return was_successful ? 0 : 1;
+  }
+
+  bool
+  test_runner::run_iteration_ (void)
+  {
+    bool was_successful = true;
+
+    current_test_suite = default_test_suite_;
+    run_registered_test_cases_ (nullptr);
+
     if (!default_test_suite_->unused ())
       {
         default_test_suite_->end_test_suite ();
@@ -158,10 +424,28 @@ namespace micro_os_plus::micro_test_plus
       {
         for (auto suite : *suites_)
           {
+            if (not should_run (suite->name ()))
+              {
+                continue;
+              }
+
             current_test_suite = suite;
+            suite->reset_counters ();
 
-            suite->begin_test_suite ();
+            // When selecting test cases, the begin is deferred to the
+            // first selected test case, and the suites without
+            // selected test cases are not reported.
+            const bool selecting = filter_ != nullptr || tag_ != nullptr;
+            if (not selecting)
+              {
+                suite->begin_test_suite ();
+              }
             suite->run ();
+            run_registered_test_cases_ (suite);
+            if (selecting && suite->unused ())
+              {
+                continue;
+              }
             suite->end_test_suite ();
 
             was_successful &= suite->was_successful ();
@@ -171,7 +455,66 @@ namespace micro_os_plus::micro_test_plus
             // printf ("\n");
           }
       }
-    return was_successful ? 0 : 1;
+
+    return was_successful;
+  }
+
+  /**
+   * @details
+   * The failure rate is displayed in per mille, to avoid
+   * the floating point formatting on embedded platforms.
+   */
+  void
+  test_runner::output_statistics_ (int iterations)
+  {
+    if (reporter.verbosity == verbosity::silent)
+      {
+        return;
+      }
+
+    std::vector<const detail::test_case_statistics*> flaky;
+    int always_failed = 0;
+    for (const auto& entry : statistics_)
+      {
+        if (entry.failures == entry.runs)
+          {
+            ++always_failed;
+          }
+        else if (entry.failures > 0)
+          {
+            flaky.push_back (&entry);
+          }
+      }
+
+    printf ("\nExecuted %d iterations, %zu test case%s failed in some "
+            "runs, %d in all runs.\n",
+            iterations, flaky.size (), flaky.size () == 1 ? "" : "s",
+            always_failed);
+
+    // The highest failure rate first.
+    std::stable_sort (flaky.begin (), flaky.end (),
+                      [] (const detail::test_case_statistics* a,
+                          const detail::test_case_statistics* b) {
+                        return static_cast<long long> (a->failures) * b->runs
+                               > static_cast<long long> (b->failures)
+                                     * a->runs;
+                      });
+
+    constexpr std::size_t max_flaky = 10;
+    for (std::size_t i = 0; i < flaky.size () && i < max_flaky; ++i)
+      {
+        const auto* entry = flaky[i];
+        const int rate = static_cast<int> (
+            static_cast<long long> (entry->failures) * 1000 / entry->runs);
+        printf ("  %3d.%d%% %s - %s (%d of %d runs failed)\n", rate / 10,
+                rate % 10, entry->suite_name.c_str (),
+                entry->test_case_name.c_str (), entry->failures,
+                entry->runs);
+      }
+    if (flaky.size () > max_flaky)
+      {
+        printf ("  ... and %zu more.\n", flaky.size () - max_flaky);
+      }
   }
 
   void
@@ -188,9 +531,342 @@ namespace micro_os_plus::micro_test_plus
     suites_->push_back (suite);
   }
 
+  void
+  test_runner::register_test_case (test_case_descriptor* descriptor)
+  {
+    if (test_cases_ == nullptr)
+      {
+        test_cases_ = new std::vector<test_case_descriptor*> ();
+      }
+    test_cases_->push_back (descriptor);
+  }
+
+  void
+  test_runner::run_registered_test_cases_ (test_suite_base* suite)
+  {
+    if (test_cases_ == nullptr)
+      {
+        return;
+      }
+
+    for (auto descriptor : *test_cases_)
+      {
+        if (descriptor->suite () != suite
+            || (tag_ != nullptr && not descriptor->has_tag (tag_)))
+          {
+            continue;
+          }
+
+        running_registered_ = true;
+        const bool selected
+            = current_test_suite->begin_test_case (descriptor->name ());
+        running_registered_ = false;
+
+        if (selected)
+          {
+            descriptor->run ();
+            current_test_suite->end_test_case ();
+          }
+      }
+  }
+
+  /**
+   * @details
+   * The registered test cases are grouped by test suites, each
+   * with its tags and source location. The test cases in `main()`
+   * and in the test suite functions are known only when
+   * executed, thus they are not listed.
+   */
+  void
+  test_runner::list_test_cases_ (void)
+  {
+    if (test_cases_ == nullptr)
+      {
+        return;
+      }
+
+    const auto list_suite = [this] (test_suite_base* suite,
+                                    const char* suite_name) {
+      bool has_header = false;
+      for (auto descriptor : *test_cases_)
+        {
+          if (descriptor->suite () != suite
+              || (tag_ != nullptr && not descriptor->has_tag (tag_))
+              || (filter_ != nullptr
+                  && not utility::is_match (descriptor->name (), filter_)))
+            {
+              continue;
+            }
+          if (not has_header)
+            {
+              printf ("%s\n", suite_name);
+              has_header = true;
+            }
+          printf ("  %s", descriptor->name ());
+          if (descriptor->tags ()[0] != '\0')
+            {
+              printf (" [%s]", descriptor->tags ());
+            }
+          printf (" (%s:%u)\n",
+                  reflection::short_name (descriptor->location ().file_name ()),
+                  static_cast<unsigned int> (descriptor->location ().line ()));
+        }
+    };
+
+    list_suite (nullptr, default_suite_name_);
+    if (suites_ != nullptr)
+      {
+        for (auto suite : *suites_)
+          {
+            list_suite (suite, suite->name ());
+          }
+      }
+  }
+
+  bool
+  test_runner::should_run (const char* suite_name,
+                           const char* test_case_name)
+  {
+    if (stopped ())
+      {
+        return false;
+      }
+
+    if (tag_ != nullptr && not running_registered_)
+      {
+        // Only the registered test cases have tags.
+        return false;
+      }
+
+    if (filter_ != nullptr && not utility::is_match (test_case_name, filter_))
+      {
+        return false;
+      }
+
+    if (not rerun_failed_)
+      {
+        return true;
+      }
+
+    const std::size_t suite_length = strlen (suite_name);
+    for (const auto& line : rerun_)
+      {
+        if (line.compare (0, suite_length, suite_name) == 0
+            && line.size () > suite_length && line[suite_length] == '\t'
+            && line.compare (suite_length + 1, std::string::npos,
+                             test_case_name)
+                   == 0)
+          {
+            return true;
+          }
+      }
+    return false;
+  }
+
+  bool
+  test_runner::should_run (const char* suite_name)
+  {
+    if (stopped ())
+      {
+        return false;
+      }
+
+    if (not rerun_failed_)
+      {
+        return true;
+      }
+
+    const std::size_t suite_length = strlen (suite_name);
+    for (const auto& line : rerun_)
+      {
+        if (line.compare (0, suite_length, suite_name) == 0
+            && line.size () > suite_length && line[suite_length] == '\t')
+          {
+            return true;
+          }
+      }
+    return false;
+  }
+
+  void
+  test_runner::record_test_case (const char* suite_name,
+                                 const char* test_case_name, bool failed)
+  {
+    if (repeat_ != 1 || until_fail_)
+      {
+        detail::test_case_statistics* entry = nullptr;
+        for (auto& e : statistics_)
+          {
+            if (e.suite_name == suite_name
+                && e.test_case_name == test_case_name)
+              {
+                entry = &e;
+                break;
+              }
+          }
+        if (entry == nullptr)
+          {
+            statistics_.push_back ({ suite_name, test_case_name, 0, 0 });
+            entry = &statistics_.back ();
+          }
+        ++entry->runs;
+        if (failed)
+          {
+            ++entry->failures;
+          }
+      }
+
+    if (not failed)
+      {
+        return;
+      }
+
+    ++failed_test_cases_;
+
+    if (state_file_.empty ())
+      {
+        return;
+      }
+
+    std::string line{ suite_name };
+    line.push_back ('\t');
+    line.append (test_case_name);
+    for (const auto& existing : failures_)
+      {
+        if (existing == line)
+          {
+            // Already failed in a previous iteration.
+            return;
+          }
+      }
+    failures_.push_back (std::move (line));
+  }
+
+  /**
+   * @details
+   * The state file has one line for each failed test case, with
+   * the suite name and the test case name separated by a tab;
+   * lines starting with `#` are comments.
+   *
+   * If the file does not exist, all test cases are executed.
+   */
+  void
+  test_runner::read_state_ (void)
+  {
+    FILE* file = state_file_.empty () ? nullptr
+                                      : fopen (state_file_.c_str (), "r");
+    if (file == nullptr)
+      {
+        rerun_failed_ = false;
+        if (reporter.verbosity != verbosity::silent)
+          {
+            printf ("No state file '%s', all test cases are executed.\n",
+                    state_file_.c_str ());
+          }
+        return;
+      }
+
+    char buf[256];
+    std::string line;
+    while (fgets (buf, sizeof (buf), file) != nullptr)
+      {
+        line.append (buf);
+        if (line.empty () || line.back () != '\n')
+          {
+            // Longer than the buffer, continue reading.
+            if (!feof (file))
+              {
+                continue;
+              }
+          }
+        while (!line.empty () && (line.back () == '\n' || line.back () == '\r'))
+          {
+            line.pop_back ();
+          }
+        if (!line.empty () && line[0] != '#')
+          {
+            rerun_.push_back (line);
+          }
+        line.clear ();
+      }
+    fclose (file);
+
+    if (reporter.verbosity == verbosity::normal
+        || reporter.verbosity == verbosity::verbose)
+      {
+        printf ("Rerunning %zu failed test case%s from '%s'.\n",
+                rerun_.size (), rerun_.size () == 1 ? "" : "s",
+                state_file_.c_str ());
+      }
+  }
+
+  /**
+   * @details
+   * With `--filter=` or `--tag=`, the test cases not selected may
+   * have failed in a previous run; with `--rerun-failed`, some of
+   * the previous failures may not have been executed; in both cases
+   * the previous state file is preserved.
+   */
+  void
+  test_runner::write_state_ (bool completed)
+  {
+    if (state_file_.empty () || filter_ != nullptr || tag_ != nullptr
+        || (rerun_failed_ && not completed))
+      {
+        return;
+      }
+
+    FILE* file = fopen (state_file_.c_str (), "w");
+    if (file == nullptr)
+      {
+        return;
+      }
+    fprintf (file, "# µTest++ failed test cases, for --rerun-failed.\n");
+    for (const auto& line : failures_)
+      {
+        fprintf (file, "%s\n", line.c_str ());
+      }
+    fclose (file);
+  }
+
+  void
+  test_runner::arm_watchdog (void)
+  {
+#if defined(MICRO_TEST_PLUS_HAS_WATCHDOG)
+    if (watchdog_ != nullptr)
+      {
+        watchdog_->arm ();
+      }
+#endif
+  }
+
+  void
+  test_runner::disarm_watchdog (void)
+  {
+#if defined(MICRO_TEST_PLUS_HAS_WATCHDOG)
+    if (watchdog_ != nullptr)
+      {
+        watchdog_->disarm ();
+      }
+#endif
+  }
+
+  void
+  test_runner::record_interrupted_test_case (void)
+  {
+    if (current_test_suite != nullptr
+        && current_test_suite->test_case_name () != nullptr)
+      {
+        record_test_case (current_test_suite->name (),
+                          current_test_suite->test_case_name (), true);
+      }
+    write_state_ (false);
+  }
+
   void
   test_runner::abort (void)
   {
+    record_interrupted_test_case ();
     ::abort ();
   }
 
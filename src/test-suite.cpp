@@ -23,6 +23,7 @@
 #include <micro-os-plus/micro-test-plus.h>
 
 #include <stdio.h>
+#include <string.h>
 
 // ----------------------------------------------------------------------------
 
@@ -75,9 +76,14 @@ namespace micro_os_plus::micro_test_plus
     reporter.end_test_suite (*this);
   }
 
-  void
+  bool
   test_suite_base::begin_test_case (const char* name)
   {
+    if (not runner.should_run (name_, name))
+      {
+        return false;
+      }
+
     if (process_deferred_begin)
       {
         begin_test_suite ();
@@ -89,19 +95,37 @@ namespace micro_os_plus::micro_test_plus
     current_test_case = {};
 
     reporter.begin_test_case (test_case_name_);
+
+    runner.arm_watchdog ();
+
+    return true;
   }
 
   void
   test_suite_base::end_test_case (void)
   {
+    runner.disarm_watchdog ();
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+    detail::merge_worker_checks (*this);
+#endif
+
+    runner.record_test_case (name_, test_case_name_,
+                             current_test_case.failed_checks > 0);
+
     reporter.end_test_case (test_case_name_);
+
+    test_case_name_ = nullptr;
   }
 
   void
-  test_suite_base::increment_successful (void)
+  test_suite_base::reset_counters (void)
   {
-    ++successful_checks_;
-    ++current_test_case.successful_checks;
+    successful_checks_ = 0;
+    failed_checks_ = 0;
+    test_cases_ = 0;
+    current_test_case = {};
+    process_deferred_begin = true;
   }
 
   void
@@ -127,6 +151,38 @@ namespace micro_os_plus::micro_test_plus
 #endif // MICRO_TEST_PLUS_TRACE
   }
 
+  // ==========================================================================
+
+  test_case_descriptor::test_case_descriptor (
+      test_suite_base* suite, const char* name, const char* tags,
+      const reflection::source_location& location)
+      : suite_{ suite }, name_{ name }, tags_{ tags }, location_{ location }
+  {
+    runner.register_test_case (this);
+  }
+
+  test_case_descriptor::~test_case_descriptor ()
+  {
+  }
+
+  bool
+  test_case_descriptor::has_tag (const char* tag) const
+  {
+    const std::size_t length = strlen (tag);
+    const char* p = tags_;
+    while (*p != '\0')
+      {
+        const std::size_t word = strcspn (p, ", ");
+        if (word == length && strncmp (p, tag, length) == 0)
+          {
+            return true;
+          }
+        p += word;
+        p += strspn (p, ", ");
+      }
+    return false;
+  }
+
   // --------------------------------------------------------------------------
 } // namespace micro_os_plus::micro_test_plus
 
@@ -0,0 +1,139 @@
+# -----------------------------------------------------------------------------
+#
+# This file is part of the µOS++ distribution.
+# (https://github.com/micro-os-plus/)
+# Copyright (c) 2022 Liviu Ionescu
+#
+# Permission to use, copy, modify, and/or distribute this software
+# for any purpose is hereby granted, under the terms of the MIT license.
+#
+# If a copy of the license was not distributed with this file, it can
+# be obtained from https://opensource.org/licenses/MIT/.
+#
+# -----------------------------------------------------------------------------
+
+# Generate a translation unit with a given number of checks of one kind.
+#
+# cmake -DKIND=comparators|literals|containers -DCHECKS=N \
+#   -DOUTPUT=file.cpp -P generate.cmake
+#
+# The checks rotate through the operators and the types, so that
+# the number of distinct template instantiations grows with N,
+# as in real tests.
+
+# -----------------------------------------------------------------------------
+
+foreach(_var KIND CHECKS OUTPUT)
+  if(NOT DEFINED ${_var})
+    message(FATAL_ERROR "${_var} must be defined")
+  endif()
+endforeach()
+
+set(_ops eq ne lt le gt ge)
+
+set(_indices "")
+if(CHECKS GREATER 0)
+  foreach(_k RANGE 1 ${CHECKS})
+    list(APPEND _indices ${_k})
+  endforeach()
+endif()
+
+set(_body "")
+
+if(KIND STREQUAL "comparators")
+  # Run-time operands, with all comparators, for the common types,
+  # and some logical functions.
+  set(_vars i u l f d)
+  foreach(_k IN LISTS _indices)
+    math(EXPR _o "${_k} % 6")
+    math(EXPR _v "${_k} % 5")
+    list(GET _ops ${_o} _op)
+    list(GET _vars ${_v} _var)
+    math(EXPR _n "${_k} % 7")
+    if(_n EQUAL 0)
+      string(APPEND _body "  mt::expect (mt::_and (mt::${_op} (${_var}, 42), mt::_not (mt::eq (i, ${_k})))) << \"check ${_k}\";\n")
+    else()
+      string(APPEND _body "  mt::expect (mt::${_op} (${_var}, ${_k})) << \"check ${_k}\";\n")
+    endif()
+  endforeach()
+elseif(KIND STREQUAL "literals")
+  # Each literal value is a distinct type, thus a distinct instantiation.
+  set(_suffixes i u l ul i8 u16 i32 u64)
+  foreach(_k IN LISTS _indices)
+    math(EXPR _o "${_k} % 6")
+    list(GET _ops ${_o} _op)
+    math(EXPR _s "${_k} % 10")
+    if(_s EQUAL 8)
+      string(APPEND _body "  mt::expect (mt::${_op} (mt::to_f{ f }, ${_k}.5_f)) << \"check ${_k}\";\n")
+    elseif(_s EQUAL 9)
+      string(APPEND _body "  mt::expect (mt::${_op} (mt::to_d{ d }, ${_k}.25_d)) << \"check ${_k}\";\n")
+    else()
+      # Keep the values in the range of the smallest types.
+      list(GET _suffixes ${_s} _suffix)
+      math(EXPR _value "${_k} % 100")
+      string(APPEND _body "  mt::expect (mt::${_op} (mt::to_${_suffix}{ ${_suffix}_v }, ${_value}_${_suffix})) << \"check ${_k}\";\n")
+    endif()
+  endforeach()
+elseif(KIND STREQUAL "containers")
+  # Vectors, arrays of several sizes, strings and ranges.
+  foreach(_k IN LISTS _indices)
+    math(EXPR _c "${_k} % 4")
+    math(EXPR _size "${_k} % 8 + 1")
+    if(_c EQUAL 0)
+      string(APPEND _body "  mt::expect (mt::eq (v, std::vector<int>{ ${_k}, ${_size} })) << \"check ${_k}\";\n")
+    elseif(_c EQUAL 1)
+      string(APPEND _body "  mt::expect (mt::ne (std::array<int, ${_size}>{}, std::array<int, ${_size}>{ ${_k} })) << \"check ${_k}\";\n")
+    elseif(_c EQUAL 2)
+      string(APPEND _body "  mt::expect (mt::eq (sv, std::string_view{ \"check ${_k}\" })) << \"check ${_k}\";\n")
+    else()
+      string(APPEND _body "  mt::expect (mt::eq_range (v, std::array<long, ${_size}>{})) << \"check ${_k}\";\n")
+    endif()
+  endforeach()
+else()
+  message(FATAL_ERROR "Unknown KIND ${KIND}")
+endif()
+
+set(_content "// Generated by generate.cmake; do not edit.
+// ${CHECKS} checks of kind '${KIND}'.
+
+#include <micro-os-plus/micro-test-plus.h>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace mt = micro_os_plus::micro_test_plus;
+using namespace mt::literals;
+
+#pragma GCC diagnostic ignored \"-Wunused-parameter\"
+#pragma GCC diagnostic ignored \"-Wunused-variable\"
+
+// The operands are parameters, to prevent the compiler from
+// evaluating the checks.
+void
+run_checks (int i, unsigned u, long l, float f, double d,
+            const std::vector<int>& v, std::string_view sv)
+{
+  unsigned long ul_v = u;
+  std::int8_t i8_v = static_cast<std::int8_t> (i);
+  std::uint16_t u16_v = static_cast<std::uint16_t> (u);
+  std::int32_t i32_v = i;
+  std::uint64_t u64_v = u;
+  int i_v = i;
+  unsigned u_v = u;
+  long l_v = l;
+
+${_body}}
+")
+
+# Write only if changed, to avoid useless rebuilds.
+if(EXISTS "${OUTPUT}")
+  file(READ "${OUTPUT}" _old)
+  if(_old STREQUAL _content)
+    return()
+  endif()
+endif()
+file(WRITE "${OUTPUT}" "${_content}")
+
+# -----------------------------------------------------------------------------
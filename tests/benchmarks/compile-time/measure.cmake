@@ -0,0 +1,139 @@
+# -----------------------------------------------------------------------------
+#
+# This file is part of the µOS++ distribution.
+# (https://github.com/micro-os-plus/)
+# Copyright (c) 2022 Liviu Ionescu
+#
+# Permission to use, copy, modify, and/or distribute this software
+# for any purpose is hereby granted, under the terms of the MIT license.
+#
+# If a copy of the license was not distributed with this file, it can
+# be obtained from https://opensource.org/licenses/MIT/.
+#
+# -----------------------------------------------------------------------------
+
+# Compile a generated translation unit and collect the metrics.
+#
+# cmake -DCOMPILER=... -DCOMPILER_ID=GNU|Clang -DFLAGS="..." \
+#   -DSOURCE=file.cpp -DOBJECT=file.o -DMETRICS=file.txt \
+#   -DNM=nm -DSIZE=size -P measure.cmake
+#
+# The metrics file has one `key=value` line per metric:
+# - wall_ms: the wall time of the compiler process
+# - parse_ms: the front-end time (GCC: phase parsing + lang. deferred,
+#   clang: Total Frontend)
+# - instantiate_ms: the time spent instantiating templates
+# - instantiations: clang: the number of function and class
+#   instantiations; GCC does not report them, so the number of
+#   µTest++ functions defined in the object is used as a proxy
+# - object_bytes: the size of the text and data sections
+
+# -----------------------------------------------------------------------------
+
+foreach(_var COMPILER COMPILER_ID SOURCE OBJECT METRICS)
+  if(NOT DEFINED ${_var})
+    message(FATAL_ERROR "${_var} must be defined")
+  endif()
+endforeach()
+
+# Convert seconds with decimals to integer milliseconds.
+function(seconds_to_ms seconds out)
+  if(seconds MATCHES "^([0-9]+)\\.([0-9]+)$")
+    set(_int "${CMAKE_MATCH_1}")
+    string(SUBSTRING "${CMAKE_MATCH_2}000" 0 3 _frac)
+    math(EXPR _ms "${_int} * 1000 + 1${_frac} - 1000")
+  else()
+    set(_ms 0)
+  endif()
+  set(${out} ${_ms} PARENT_SCOPE)
+endfunction()
+
+separate_arguments(_flags UNIX_COMMAND "${FLAGS}")
+
+if(COMPILER_ID STREQUAL "Clang")
+  list(APPEND _flags -ftime-trace -ftime-trace-granularity=0)
+else()
+  list(APPEND _flags -ftime-report)
+endif()
+
+string(TIMESTAMP _start "%s%f" UTC)
+execute_process(
+  COMMAND "${COMPILER}" ${_flags} -c "${SOURCE}" -o "${OBJECT}"
+  RESULT_VARIABLE _result
+  ERROR_VARIABLE _stderr
+)
+string(TIMESTAMP _stop "%s%f" UTC)
+if(NOT _result EQUAL 0)
+  message(FATAL_ERROR "Compiling ${SOURCE} failed:\n${_stderr}")
+endif()
+math(EXPR _wall_ms "(${_stop} - ${_start}) / 1000")
+
+set(_parse_ms 0)
+set(_instantiate_ms 0)
+set(_instantiations 0)
+
+if(COMPILER_ID STREQUAL "Clang")
+  # The trace is written next to the object, with the .json extension.
+  get_filename_component(_dir "${OBJECT}" DIRECTORY)
+  get_filename_component(_name "${OBJECT}" NAME_WE)
+  file(READ "${_dir}/${_name}.json" _trace)
+  if(_trace MATCHES "\"dur\":([0-9]+),\"name\":\"Total Frontend\"")
+    math(EXPR _parse_ms "${CMAKE_MATCH_1} / 1000")
+  endif()
+  set(_total 0)
+  foreach(_event InstantiateFunction InstantiateClass)
+    if(_trace MATCHES "\"dur\":([0-9]+),\"name\":\"Total ${_event}\"")
+      math(EXPR _total "${_total} + ${CMAKE_MATCH_1}")
+    endif()
+    string(REGEX MATCHALL "\"name\":\"${_event}\"" _matches "${_trace}")
+    list(LENGTH _matches _count)
+    math(EXPR _instantiations "${_instantiations} + ${_count}")
+  endforeach()
+  math(EXPR _instantiate_ms "${_total} / 1000")
+else()
+  # The wall time is the third column.
+  set(_time_re ":[ ]+[0-9.]+ \\([ 0-9]+%\\)[ ]+[0-9.]+ \\([ 0-9]+%\\)[ ]+([0-9.]+)")
+  foreach(_phase "phase parsing" "phase lang. deferred")
+    if(_stderr MATCHES "${_phase}[ ]+${_time_re}")
+      seconds_to_ms(${CMAKE_MATCH_1} _ms)
+      math(EXPR _parse_ms "${_parse_ms} + ${_ms}")
+    endif()
+  endforeach()
+  if(_stderr MATCHES "template instantiation[ ]+${_time_re}")
+    seconds_to_ms(${CMAKE_MATCH_1} _instantiate_ms)
+  endif()
+
+  if(NM)
+    execute_process(
+      COMMAND "${NM}" --demangle --defined-only "${OBJECT}"
+      OUTPUT_VARIABLE _symbols
+    )
+    string(REGEX MATCHALL "[^\n]*micro_os_plus::micro_test_plus[^\n]*\n"
+      _matches "${_symbols}")
+    list(LENGTH _matches _instantiations)
+  endif()
+endif()
+
+set(_object_bytes 0)
+if(SIZE)
+  # Berkeley format: text data bss dec hex filename.
+  execute_process(
+    COMMAND "${SIZE}" "${OBJECT}"
+    OUTPUT_VARIABLE _size
+  )
+  if(_size MATCHES "\n[ \t]*([0-9]+)[ \t]+([0-9]+)")
+    math(EXPR _object_bytes "${CMAKE_MATCH_1} + ${CMAKE_MATCH_2}")
+  endif()
+else()
+  file(SIZE "${OBJECT}" _object_bytes)
+endif()
+
+file(WRITE "${METRICS}"
+  "wall_ms=${_wall_ms}\n"
+  "parse_ms=${_parse_ms}\n"
+  "instantiate_ms=${_instantiate_ms}\n"
+  "instantiations=${_instantiations}\n"
+  "object_bytes=${_object_bytes}\n"
+)
+
+# -----------------------------------------------------------------------------
@@ -0,0 +1,83 @@
+# -----------------------------------------------------------------------------
+#
+# This file is part of the µOS++ distribution.
+# (https://github.com/micro-os-plus/)
+# Copyright (c) 2022 Liviu Ionescu
+#
+# Permission to use, copy, modify, and/or distribute this software
+# for any purpose is hereby granted, under the terms of the MIT license.
+#
+# If a copy of the license was not distributed with this file, it can
+# be obtained from https://opensource.org/licenses/MIT/.
+#
+# -----------------------------------------------------------------------------
+
+# Collect the metrics of all generated translation units in a table.
+#
+# cmake -DKINDS=a,b -DCHECKS=0,N,M -DMETRICS_DIR=dir \
+#   -DOUTPUT=report.md -P report.cmake
+#
+# The translation units with 0 checks are the baseline (the cost of
+# parsing the headers); the per check values are the differences
+# to the baseline, divided by the number of checks.
+
+# -----------------------------------------------------------------------------
+
+foreach(_var KINDS CHECKS METRICS_DIR OUTPUT)
+  if(NOT DEFINED ${_var})
+    message(FATAL_ERROR "${_var} must be defined")
+  endif()
+endforeach()
+
+string(REPLACE "," ";" KINDS "${KINDS}")
+string(REPLACE "," ";" CHECKS "${CHECKS}")
+
+function(read_metrics file prefix)
+  file(STRINGS "${file}" _lines)
+  foreach(_line IN LISTS _lines)
+    if(_line MATCHES "^([a-z_]+)=([0-9]+)$")
+      set(${prefix}_${CMAKE_MATCH_1} ${CMAKE_MATCH_2} PARENT_SCOPE)
+    endif()
+  endforeach()
+endfunction()
+
+# Format a value multiplied by 1000 as a number with 3 decimals.
+function(format_milli value out)
+  if(value LESS 0)
+    set(_sign "-")
+    math(EXPR value "0 - ${value}")
+  else()
+    set(_sign "")
+  endif()
+  math(EXPR _int "${value} / 1000")
+  math(EXPR _frac "${value} % 1000 + 1000")
+  string(SUBSTRING "${_frac}" 1 3 _frac)
+  set(${out} "${_sign}${_int}.${_frac}" PARENT_SCOPE)
+endfunction()
+
+set(_report "# µTest++ compile-time benchmark\n\n")
+string(APPEND _report "| Kind | Checks | Wall ms | Front-end ms | Instantiation ms | Instantiations | Object bytes | ms/check | Instantiations/check | Bytes/check |\n")
+string(APPEND _report "|---|--:|--:|--:|--:|--:|--:|--:|--:|--:|\n")
+
+foreach(_kind IN LISTS KINDS)
+  read_metrics("${METRICS_DIR}/${_kind}-0.txt" _base)
+  foreach(_n IN LISTS CHECKS)
+    read_metrics("${METRICS_DIR}/${_kind}-${_n}.txt" _m)
+    string(APPEND _report "| ${_kind} | ${_n} | ${_m_wall_ms} | ${_m_parse_ms} | ${_m_instantiate_ms} | ${_m_instantiations} | ${_m_object_bytes} |")
+    if(_n GREATER 0)
+      math(EXPR _ms "(${_m_wall_ms} - ${_base_wall_ms}) * 1000 / ${_n}")
+      math(EXPR _inst "(${_m_instantiations} - ${_base_instantiations}) * 1000 / ${_n}")
+      math(EXPR _bytes "(${_m_object_bytes} - ${_base_object_bytes}) / ${_n}")
+      format_milli(${_ms} _ms)
+      format_milli(${_inst} _inst)
+      string(APPEND _report " ${_ms} | ${_inst} | ${_bytes} |\n")
+    else()
+      string(APPEND _report " - | - | - |\n")
+    endif()
+  endforeach()
+endforeach()
+
+file(WRITE "${OUTPUT}" "${_report}")
+message(STATUS "Report written to ${OUTPUT}\n\n${_report}")
+
+# -----------------------------------------------------------------------------
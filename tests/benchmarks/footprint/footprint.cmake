@@ -0,0 +1,225 @@
+# -----------------------------------------------------------------------------
+#
+# This file is part of the µOS++ distribution.
+# (https://github.com/micro-os-plus/)
+# Copyright (c) 2022 Liviu Ionescu
+#
+# Permission to use, copy, modify, and/or distribute this software
+# for any purpose is hereby granted, under the terms of the MIT license.
+#
+# If a copy of the license was not distributed with this file, it can
+# be obtained from https://opensource.org/licenses/MIT/.
+#
+# -----------------------------------------------------------------------------
+
+# Measure the memory footprint of the canonical programs and compare
+# it to the checked-in baseline.
+#
+# cmake -DREFERENCE=footprint-test-0.elf -DPROGRAM=footprint-test.elf \
+#   -DCHECKS=N -DNAME=platform-compiler-buildtype \
+#   -DSIZE=size -DNM=nm -DBASELINES_DIR=dir -DOUTPUT=footprint.md \
+#   [-DTOLERANCE=1] [-DUPDATE=ON] -P footprint.cmake
+#
+# The reference has the same framework calls but a single check,
+# thus its size is the cost of the framework; the difference to the
+# program with N additional checks gives the marginal bytes per check.
+#
+# The baseline is a text file with `key=value` lines and one
+# `symbol=<bytes> <name>` line for each µTest++ symbol; it is
+# written only with -DUPDATE=ON, otherwise the build fails if any
+# of the totals exceeds the baseline by more than TOLERANCE percent
+# (default 1); without a baseline, only the report is written, with
+# a warning.
+
+# -----------------------------------------------------------------------------
+
+# For if(IN_LIST) and continue().
+cmake_minimum_required(VERSION 3.20)
+
+foreach(_var REFERENCE PROGRAM CHECKS NAME SIZE NM BASELINES_DIR OUTPUT)
+  if(NOT DEFINED ${_var})
+    message(FATAL_ERROR "${_var} must be defined")
+  endif()
+endforeach()
+
+if(NOT DEFINED TOLERANCE)
+  set(TOLERANCE 1)
+endif()
+
+# Berkeley format: text data bss dec hex filename.
+function(measure_sections file prefix)
+  execute_process(
+    COMMAND "${SIZE}" --format=berkeley "${file}"
+    OUTPUT_VARIABLE _size
+    RESULT_VARIABLE _result
+  )
+  if(NOT _result EQUAL 0
+     OR NOT _size MATCHES "\n[ \t]*([0-9]+)[ \t]+([0-9]+)[ \t]+([0-9]+)")
+    message(FATAL_ERROR "Cannot get the size of ${file}")
+  endif()
+  set(${prefix}_text ${CMAKE_MATCH_1} PARENT_SCOPE)
+  set(${prefix}_data ${CMAKE_MATCH_2} PARENT_SCOPE)
+  set(${prefix}_bss ${CMAKE_MATCH_3} PARENT_SCOPE)
+endfunction()
+
+# The µTest++ symbols, as `<bytes> <type> <name>`, largest first.
+function(measure_symbols file out)
+  execute_process(
+    COMMAND "${NM}" --print-size --size-sort --reverse-sort --demangle
+      --defined-only "${file}"
+    OUTPUT_VARIABLE _symbols
+    RESULT_VARIABLE _result
+  )
+  if(NOT _result EQUAL 0)
+    message(FATAL_ERROR "Cannot list the symbols of ${file}")
+  endif()
+  # Semicolons and brackets confuse the CMake lists.
+  string(REPLACE ";" "," _symbols "${_symbols}")
+  string(REPLACE "[" "(" _symbols "${_symbols}")
+  string(REPLACE "]" ")" _symbols "${_symbols}")
+  string(REPLACE "\n" ";" _lines "${_symbols}")
+  set(_result "")
+  foreach(_line IN LISTS _lines)
+    if(_line MATCHES "^[0-9a-fA-F]+ ([0-9a-fA-F]+) ([A-Za-z]) (.*micro_os_plus::micro_test_plus.*)$")
+      math(EXPR _bytes "0x${CMAKE_MATCH_1}" OUTPUT_FORMAT DECIMAL)
+      list(APPEND _result "${_bytes} ${CMAKE_MATCH_2} ${CMAKE_MATCH_3}")
+    endif()
+  endforeach()
+  set(${out} "${_result}" PARENT_SCOPE)
+endfunction()
+
+measure_sections("${REFERENCE}" _ref)
+measure_sections("${PROGRAM}" _prog)
+measure_symbols("${PROGRAM}" _symbols)
+
+set(_keys text data bss)
+foreach(_key IN LISTS _keys)
+  set(_m_reference_${_key} ${_ref_${_key}})
+  set(_m_program_${_key} ${_prog_${_key}})
+  math(EXPR _m_per_check_${_key}
+    "(${_prog_${_key}} - ${_ref_${_key}}) / ${CHECKS}")
+endforeach()
+
+# -----------------------------------------------------------------------------
+# Compare to the baseline.
+
+set(_baseline "${BASELINES_DIR}/${NAME}.txt")
+set(_status "")
+set(_missing OFF)
+
+if(NOT UPDATE AND NOT EXISTS "${_baseline}")
+  # Do not silently create it, a new baseline must be reviewed.
+  set(_missing ON)
+elseif(NOT UPDATE)
+  file(STRINGS "${_baseline}" _lines)
+  set(_base_symbols "")
+  foreach(_line IN LISTS _lines)
+    if(_line MATCHES "^symbol=([0-9]+) (.*)$")
+      set("_b_symbol_${CMAKE_MATCH_2}" ${CMAKE_MATCH_1})
+      list(APPEND _base_symbols "${CMAKE_MATCH_2}")
+    elseif(_line MATCHES "^([a-z_]+)=([0-9-]+)$")
+      set(_b_${CMAKE_MATCH_1} ${CMAKE_MATCH_2})
+    endif()
+  endforeach()
+
+  set(_regressions "")
+  foreach(_what reference program)
+    foreach(_key IN LISTS _keys)
+      set(_new ${_m_${_what}_${_key}})
+      set(_old ${_b_${_what}_${_key}})
+      if("${_old}" STREQUAL "")
+        continue()
+      endif()
+      math(EXPR _limit "${_old} + ${_old} * ${TOLERANCE} / 100")
+      if(_new GREATER _limit)
+        math(EXPR _delta "${_new} - ${_old}")
+        list(APPEND _regressions "${_what} .${_key}: ${_old} -> ${_new} (+${_delta})")
+      endif()
+    endforeach()
+  endforeach()
+
+  # The symbols that changed, for information.
+  set(_changes "")
+  set(_new_names "")
+  foreach(_entry IN LISTS _symbols)
+    string(REGEX MATCH "^([0-9]+) [A-Za-z] (.*)$" _ignore "${_entry}")
+    set(_bytes ${CMAKE_MATCH_1})
+    set(_name "${CMAKE_MATCH_2}")
+    list(APPEND _new_names "${_name}")
+    if(NOT DEFINED "_b_symbol_${_name}")
+      list(APPEND _changes "| + | ${_bytes} | `${_name}` |")
+    elseif(NOT _bytes EQUAL "${_b_symbol_${_name}}")
+      math(EXPR _delta "${_bytes} - ${_b_symbol_${_name}}")
+      list(APPEND _changes "| ${_delta} | ${_bytes} | `${_name}` |")
+    endif()
+  endforeach()
+  foreach(_name IN LISTS _base_symbols)
+    if(NOT "${_name}" IN_LIST _new_names)
+      list(APPEND _changes "| - | ${_b_symbol_${_name}} | `${_name}` |")
+    endif()
+  endforeach()
+else()
+  set(_content "# Footprint baseline for ${NAME}; regenerate with -DFOOTPRINT_UPDATE_BASELINE=ON.\n")
+  string(APPEND _content "checks=${CHECKS}\n")
+  foreach(_what reference program per_check)
+    foreach(_key IN LISTS _keys)
+      string(APPEND _content "${_what}_${_key}=${_m_${_what}_${_key}}\n")
+    endforeach()
+  endforeach()
+  foreach(_entry IN LISTS _symbols)
+    string(REGEX MATCH "^([0-9]+) [A-Za-z] (.*)$" _ignore "${_entry}")
+    string(APPEND _content "symbol=${CMAKE_MATCH_1} ${CMAKE_MATCH_2}\n")
+  endforeach()
+  file(WRITE "${_baseline}" "${_content}")
+  set(_status "Baseline written to ${_baseline}.")
+endif()
+
+# -----------------------------------------------------------------------------
+# Write the report.
+
+set(_report "# µTest++ footprint, ${NAME}\n\n")
+string(APPEND _report "| | .text | .data | .bss |\n")
+string(APPEND _report "|---|--:|--:|--:|\n")
+string(APPEND _report "| Reference (framework) | ${_m_reference_text} | ${_m_reference_data} | ${_m_reference_bss} |\n")
+string(APPEND _report "| Program (${CHECKS} more checks) | ${_m_program_text} | ${_m_program_data} | ${_m_program_bss} |\n")
+string(APPEND _report "| Per check | ${_m_per_check_text} | ${_m_per_check_data} | ${_m_per_check_bss} |\n")
+if(DEFINED _b_program_text)
+  string(APPEND _report "| Baseline reference | ${_b_reference_text} | ${_b_reference_data} | ${_b_reference_bss} |\n")
+  string(APPEND _report "| Baseline program | ${_b_program_text} | ${_b_program_data} | ${_b_program_bss} |\n")
+endif()
+
+string(APPEND _report "\n## Symbols\n\n")
+string(APPEND _report "| Bytes | Type | Symbol |\n")
+string(APPEND _report "|--:|:-:|---|\n")
+foreach(_entry IN LISTS _symbols)
+  string(REGEX MATCH "^([0-9]+) ([A-Za-z]) (.*)$" _ignore "${_entry}")
+  string(APPEND _report "| ${CMAKE_MATCH_1} | ${CMAKE_MATCH_2} | `${CMAKE_MATCH_3}` |\n")
+endforeach()
+
+if(_changes)
+  string(APPEND _report "\n## Changes to the baseline\n\n")
+  string(APPEND _report "| Delta | Bytes | Symbol |\n")
+  string(APPEND _report "|--:|--:|---|\n")
+  foreach(_line IN LISTS _changes)
+    string(APPEND _report "${_line}\n")
+  endforeach()
+endif()
+
+file(WRITE "${OUTPUT}" "${_report}")
+
+message(STATUS "${NAME}: framework ${_m_reference_text}/${_m_reference_data}/${_m_reference_bss}, per check ${_m_per_check_text}/${_m_per_check_data}/${_m_per_check_bss} bytes (text/data/bss)")
+message(STATUS "Report written to ${OUTPUT}")
+if(_status)
+  message(STATUS "${_status}")
+endif()
+
+if(_missing)
+  message(WARNING "No footprint baseline ${_baseline}, nothing to compare.\nSee ${OUTPUT}; to create it, use -DFOOTPRINT_UPDATE_BASELINE=ON, check the values and commit it.")
+endif()
+
+if(_regressions)
+  list(JOIN _regressions "\n  " _text)
+  message(FATAL_ERROR "Footprint regression for ${NAME} (more than ${TOLERANCE}% over the baseline):\n  ${_text}\nSee ${OUTPUT}; if intended, update the baseline with -DFOOTPRINT_UPDATE_BASELINE=ON.")
+endif()
+
+# -----------------------------------------------------------------------------
@@ -93,3 +93,53 @@ add_subdirectory(".." "top-bin")
 add_subdirectory("platforms/${PLATFORM_NAME}" "platform-bin")
 
 # -----------------------------------------------------------------------------
+# Footprint #
+
+# `cmake --build <folder> --target footprint` compares the size of
+# the canonical programs to the baseline of the platform, compiler
+# and build type, in `benchmarks/footprint/baselines`.
+if(ENABLE_FOOTPRINT_TEST)
+  # The number of checks in `src/footprint-test.cpp`, in addition
+  # to the reference one.
+  set(footprint_checks 32)
+
+  set(FOOTPRINT_UPDATE_BASELINE OFF CACHE BOOL
+    "Overwrite the footprint baseline with the current values")
+  set(FOOTPRINT_TOLERANCE 1 CACHE STRING
+    "The footprint increase (percent) accepted before failing")
+
+  # The toolchain files define CMAKE_SIZE for the cross compilers;
+  # for the native builds, use the one next to nm.
+  if(NOT CMAKE_SIZE)
+    get_filename_component(_nm_dir "${CMAKE_NM}" DIRECTORY)
+    get_filename_component(_nm_name "${CMAKE_NM}" NAME)
+    string(REGEX REPLACE "nm(\\.exe|)$" "size\\1" _size_name "${_nm_name}")
+    find_program(CMAKE_SIZE NAMES "${_size_name}" size llvm-size
+      HINTS "${_nm_dir}")
+  endif()
+
+  string(REGEX MATCH "^[0-9]+" _compiler_major "${CMAKE_CXX_COMPILER_VERSION}")
+  string(TOLOWER
+    "${PLATFORM_NAME}-${CMAKE_CXX_COMPILER_ID}${_compiler_major}-${CMAKE_BUILD_TYPE}"
+    _footprint_name)
+
+  add_custom_target(footprint
+    COMMAND "${CMAKE_COMMAND}"
+      "-DREFERENCE=$<TARGET_FILE:footprint-test-0>"
+      "-DPROGRAM=$<TARGET_FILE:footprint-test>"
+      "-DCHECKS=${footprint_checks}"
+      "-DNAME=${_footprint_name}"
+      "-DSIZE=${CMAKE_SIZE}"
+      "-DNM=${CMAKE_NM}"
+      "-DBASELINES_DIR=${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/footprint/baselines"
+      "-DOUTPUT=${CMAKE_BINARY_DIR}/footprint.md"
+      "-DTOLERANCE=${FOOTPRINT_TOLERANCE}"
+      "-DUPDATE=${FOOTPRINT_UPDATE_BASELINE}"
+      -P "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/footprint/footprint.cmake"
+    DEPENDS footprint-test-0 footprint-test
+    COMMENT "Checking the footprint of ${_footprint_name}"
+    VERBATIM
+  )
+endif()
+
+# -----------------------------------------------------------------------------
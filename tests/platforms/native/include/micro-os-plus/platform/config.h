@@ -24,6 +24,9 @@
 #define MICRO_TEST_PLUS_TRACE
 #endif // MICRO_OS_PLUS_TRACE
 
+// The unit tests also check from other threads.
+#define MICRO_TEST_PLUS_THREAD_SAFE
+
 // ----------------------------------------------------------------------------
 
 #endif /* MICRO_OS_PLUS_PLATFORM_CONFIG_H_ */
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+// ----------------------------------------------------------------------------
+
+// The canonical program used to measure the memory footprint.
+//
+// It is built twice, once with all checks and once without them
+// (`footprint-test-0.cpp`); the first one gives the size of the
+// framework, the difference gives the marginal cost of an `expect()`.
+//
+// The checks are typical of real tests (integers of several types,
+// floating point values, strings, pointers, logical functions);
+// the operands depend on `argc`, to prevent the compiler from
+// evaluating them.
+//
+// The number of checks in addition to the reference one (32)
+// must match `footprint_checks` in `tests/cmake/tests-main.cmake`.
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+#include <cstdint>
+#include <string_view>
+
+// ----------------------------------------------------------------------------
+
+namespace mt = micro_os_plus::micro_test_plus;
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wshadow-uncaptured-local"
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+#pragma clang diagnostic ignored "-Wglobal-constructors"
+#pragma clang diagnostic ignored "-Wctad-maybe-unsupported"
+#pragma clang diagnostic ignored "-Wunknown-warning-option"
+#endif
+
+// ----------------------------------------------------------------------------
+
+int
+main (int argc, char* argv[])
+{
+  mt::initialize (argc, argv, "Footprint");
+
+  // argc is at least 1 on all platforms (semihosting passes the
+  // program name), but the compiler cannot know it.
+  const int i = (argc > 0) ? 42 : 0;
+
+  mt::test_case ("Footprint", [&] {
+#if !defined(FOOTPRINT_TEST_WITHOUT_CHECKS)
+    const unsigned u = static_cast<unsigned> (i);
+    const long l = i;
+    const std::int8_t i8 = static_cast<std::int8_t> (i);
+    const std::uint16_t u16 = static_cast<std::uint16_t> (i);
+    const std::uint64_t u64 = static_cast<std::uint64_t> (i);
+    const float f = static_cast<float> (i);
+    const double d = i;
+    const std::string_view sv{ i == 42 ? "answer" : "none" };
+    const char* s = sv.data ();
+    int n = i;
+    int* p = &n;
+
+    // Integers.
+    mt::expect (mt::eq (i, 42)) << "i == 42";
+    mt::expect (mt::ne (i, 43)) << "i != 43";
+    mt::expect (mt::lt (i, 43)) << "i < 43";
+    mt::expect (mt::le (i, 42)) << "i <= 42";
+    mt::expect (mt::gt (i, 41)) << "i > 41";
+    mt::expect (mt::ge (i, 42)) << "i >= 42";
+    mt::expect (mt::eq (u, 42u)) << "u == 42";
+    mt::expect (mt::ne (u, 0u)) << "u != 0";
+    mt::expect (mt::eq (l, 42l)) << "l == 42";
+    mt::expect (mt::gt (l, 0l)) << "l > 0";
+    mt::expect (mt::eq (i8, 42)) << "i8 == 42";
+    mt::expect (mt::eq (u16, 42)) << "u16 == 42";
+    mt::expect (mt::le (u16, 100)) << "u16 <= 100";
+    mt::expect (mt::eq (u64, 42ull)) << "u64 == 42";
+    mt::expect (mt::lt (u64, 100ull)) << "u64 < 100";
+
+    // Floating point.
+    mt::expect (mt::eq (f, 42.0f)) << "f == 42";
+    mt::expect (mt::lt (f, 42.5f)) << "f < 42.5";
+    mt::expect (mt::eq (d, 42.0)) << "d == 42";
+    mt::expect (mt::ge (d, 0.0)) << "d >= 0";
+
+    // Strings.
+    mt::expect (mt::eq (sv, std::string_view{ "answer" })) << "sv";
+    mt::expect (mt::ne (sv, std::string_view{ "question" })) << "sv";
+    mt::expect (mt::eq (s, "answer")) << "s";
+    mt::expect (mt::ne (s, "question")) << "s";
+
+    // Pointers.
+    mt::expect (mt::eq (p, &n)) << "p == &n";
+    mt::expect (mt::ne (p, nullptr)) << "p != nullptr";
+
+    // Logical functions.
+    mt::expect (mt::_and (mt::eq (i, 42), mt::ne (u, 0u))) << "and";
+    mt::expect (mt::_or (mt::eq (i, 0), mt::eq (l, 42l))) << "or";
+    mt::expect (mt::_not (mt::eq (i, 0))) << "not";
+
+    // Plain boolean expressions.
+    mt::expect (i == 42) << "bool";
+    mt::expect (sv.size () == 6) << "size";
+    mt::expect (p != nullptr) << "pointer";
+
+    // Assumptions.
+    mt::assume (mt::eq (i, 42)) << "assume i == 42";
+    mt::assume (i > 0) << "assume i > 0";
+#else
+    // Keep the lambda non-empty, to avoid optimising it away.
+    mt::expect (i == 42) << "bool";
+#endif
+  });
+
+  return mt::exit_code ();
+}
+
+// ----------------------------------------------------------------------------
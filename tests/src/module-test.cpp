@@ -0,0 +1,86 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+// ----------------------------------------------------------------------------
+
+// The same checks as the minimal test, but using the C++20 module
+// instead of the headers; built only when the compiler supports it.
+
+import micro_os_plus.micro_test_plus;
+
+#include <string_view>
+
+// ----------------------------------------------------------------------------
+
+namespace mt = micro_os_plus::micro_test_plus;
+using namespace std::literals;
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+#pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+
+// ----------------------------------------------------------------------------
+
+// Simple examples of functions to be tested.
+static int
+compute_answer (void)
+{
+  return 42;
+}
+
+static bool
+compute_condition (void)
+{
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+static mt::test_suite ts_module
+    = { "Separate", [] {
+         mt::test_case ("Check a separate test suite", [] {
+           mt::expect (mt::ne (compute_answer (), 43)) << "answer is not 43";
+         });
+       } };
+
+// ----------------------------------------------------------------------------
+
+int
+main (int argc, char* argv[])
+{
+  mt::initialize (argc, argv, "Module");
+
+  mt::test_case ("Check various conditions", [] {
+    mt::expect (mt::eq (compute_answer (), 42)) << "answer is 42";
+    mt::expect (compute_condition ()) << "condition is true";
+    mt::expect (mt::eq ("abc"sv, "abc"sv)) << "string views are equal";
+  });
+
+  mt::test_case ("Check operators and literals", [] {
+    using namespace mt::operators;
+    using namespace mt::literals;
+
+    mt::expect (compute_answer () == 42_i) << "answer == 42_i";
+    mt::expect (mt::_f (42.10f) == 42.1_f) << "42.10f == 42.1_f";
+    mt::expect (compute_answer () > 0_i and compute_condition ())
+        << "answer > 0_i and condition";
+  });
+
+  return mt::exit_code ();
+}
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,80 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+// ----------------------------------------------------------------------------
+
+// Test cases with known results, to check the runner options that
+// select, stop and repeat the execution: `--fail-fast`,
+// `--max-failures=`, `--repeat=`, `--until-fail`, `--state-file=`
+// and `--rerun-failed`. The results are checked by the test harness,
+// from the output and the exit code.
+// Hosted platforms only.
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+// ----------------------------------------------------------------------------
+
+namespace mt = micro_os_plus::micro_test_plus;
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+// The test cases are in a test suite, since only the test suites and
+// the registered test cases are executed again by `--repeat=`.
+static mt::test_suite ts_runner_options
+    = { "Runner Options", [] {
+         mt::test_case ("Check passed first", [] {
+           mt::expect (true) << "passed";
+         });
+
+         mt::test_case ("Check failed first", [] {
+           mt::expect (false) << "always failed";
+         });
+
+         // Deliberately flaky: it passes in the odd runs and fails in
+         // the even ones.
+         mt::test_case ("Check flaky", [] {
+           static int runs = 0;
+           ++runs;
+           mt::expect (runs % 2 == 1) << "failed in the even runs";
+         });
+
+         mt::test_case ("Check failed second", [] {
+           mt::expect (false) << "always failed";
+         });
+
+         mt::test_case ("Check passed last", [] {
+           mt::expect (true) << "passed";
+         });
+       } };
+
+// ----------------------------------------------------------------------------
+
+int
+main (int argc, char* argv[])
+{
+  mt::initialize (argc, argv, "Runner Options");
+
+  return mt::exit_code ();
+}
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,62 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+// ----------------------------------------------------------------------------
+
+// A test case that never ends, to check that `--timeout=` terminates
+// the process with exit code 124 and names the test case.
+// Hosted platforms only.
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/micro-test-plus.h>
+
+#include <chrono>
+#include <thread>
+
+// ----------------------------------------------------------------------------
+
+namespace mt = micro_os_plus::micro_test_plus;
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+int
+main (int argc, char* argv[])
+{
+  mt::initialize (argc, argv, "Timeout");
+
+  mt::test_case ("Check before the timeout", [] {
+    mt::expect (true) << "passed";
+  });
+
+  mt::test_case ("Check blocked forever", [] {
+    mt::expect (true) << "last passed";
+
+    for (;;)
+      {
+        std::this_thread::sleep_for (std::chrono::seconds (1));
+      }
+  });
+
+  return mt::exit_code ();
+}
+
+// ----------------------------------------------------------------------------
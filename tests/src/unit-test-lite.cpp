@@ -0,0 +1,22 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2021 Liviu Ionescu.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+// ----------------------------------------------------------------------------
+
+// The same unit tests, with the comparators reported via the
+// type-erased lite expressions; the counts must be identical.
+
+#define MICRO_TEST_PLUS_LITE
+
+#include "unit-test.cpp"
+
+// ----------------------------------------------------------------------------
@@ -14,9 +14,13 @@
 
 #include <micro-os-plus/micro-test-plus.h>
 
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <stdio.h>
+#include <string>
 #include <vector>
 #include <string_view>
 
@@ -24,6 +28,12 @@
 #include <stdexcept>
 #endif // defined(__EXCEPTIONS)
 
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif // defined(MICRO_TEST_PLUS_THREAD_SAFE)
+
 using namespace std::literals;
 
 // For this test only, make the namespaces globally visible.
@@ -42,6 +52,7 @@ using namespace micro_os_plus::micro_test_plus;
 #pragma GCC diagnostic ignored "-Wsign-compare"
 #pragma GCC diagnostic ignored "-Wdouble-promotion"
 #pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wpadded"
 
 // ----------------------------------------------------------------------------
 
@@ -156,6 +167,88 @@ exercise_throw (bool mustThrow)
 
 #endif // __EXCEPTIONS)
 
+// A reporter that keeps the text, to check the erased expressions.
+class capture_reporter : public test_reporter
+{
+public:
+  const std::string&
+  text (void) const
+  {
+    return out_;
+  }
+};
+
+// A register, as the sequential model of linearizability checks.
+struct register_operation
+{
+  bool write;
+  int value;
+};
+
+struct register_model
+{
+  int value = 0;
+
+  int
+  apply (const register_operation& operation)
+  {
+    if (operation.write)
+      {
+        value = operation.value;
+        return 0;
+      }
+    return value;
+  }
+
+  bool
+  operator== (const register_model&) const
+      = default;
+};
+
+// A driver interface, mocked.
+class bus_interface
+{
+public:
+  virtual ~bus_interface () = default;
+
+  virtual int
+  write (std::uint8_t address, std::size_t size)
+      = 0;
+
+  virtual void
+  select (bool enable)
+      = 0;
+};
+
+class bus_mock : public bus_interface
+{
+public:
+  mock::call_log<256> log;
+  mock::method<int (std::uint8_t, std::size_t)> write_{ log, "write" };
+  mock::method<void (bool)> select_{ log, "select" };
+
+  virtual int
+  write (std::uint8_t address, std::size_t size) override
+  {
+    return write_ (address, size);
+  }
+
+  virtual void
+  select (bool enable) override
+  {
+    select_ (enable);
+  }
+};
+
+static int
+send_to_bus (bus_interface& bus, std::uint8_t address)
+{
+  bus.select (true);
+  const int result = bus.write (address, 2);
+  bus.select (false);
+  return result;
+}
+
 // ----------------------------------------------------------------------------
 
 int
@@ -464,6 +557,40 @@ main (int argc, char* argv[])
 
   // --------------------------------------------------------------------------
 
+  test_case ("Static expectations", [] {
+    using namespace literals;
+
+    static constexpr int table[] = { 1, 2, 42 };
+
+    static_expect<eq (42_i, 42_i)> ();
+    local_counts.successful_checks++;
+
+    static_expect<ne (table[2], 43)> ();
+    local_counts.successful_checks++;
+
+    static_expect<lt (table[0], table[1])> ();
+    local_counts.successful_checks++;
+
+    static_expect<_and (ge (42_u, 42_u), gt (table[2], 41))> ();
+    local_counts.successful_checks++;
+
+    static_expect<eq (1.5_d, 1.5_d)> ();
+    local_counts.successful_checks++;
+
+    static_expect<(sizeof (table) == 3 * sizeof (int))> ();
+    local_counts.successful_checks++;
+
+    local_counts.test_cases++;
+  });
+
+  test_assert (current_test_suite->successful_checks ()
+               == local_counts.successful_checks);
+  test_assert (current_test_suite->failed_checks ()
+               == local_counts.failed_checks);
+  test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+  // --------------------------------------------------------------------------
+
   test_case ("Float comparisons", [] {
     expect (eq (my_actual_float<float> (), 42.0f)) << "actual == 42.0f";
     local_counts.successful_checks++;
@@ -519,6 +646,20 @@ main (int argc, char* argv[])
       expect (ne (_f (42.101f), 42.100_f)) << "42.101f != 42.100_f";
       local_counts.successful_checks++;
 
+      // Each value has its own epsilon; creating another value with
+      // a different precision must not change it.
+      const _f precise{ 42.101f, 0.0001f };
+      const _f coarse{ 42.101f, 0.1f };
+      expect (ne (precise, 42.10_f)) << "precise 42.101f != 42.10_f";
+      local_counts.successful_checks++;
+
+      expect (eq (coarse, 42.10_f)) << "coarse 42.101f == 42.10_f";
+      local_counts.successful_checks++;
+
+      // For constants, the default epsilon is computed at compile time.
+      static_assert (_d{ 1.25 }.epsilon_ > 0.009
+                     && _d{ 1.25 }.epsilon_ < 0.011);
+
       expect (eq (_f (42.10f), 42.1_f)) << "42.10f == 42.1_f";
       local_counts.successful_checks++;
 
@@ -707,6 +848,50 @@ main (int argc, char* argv[])
         << "actual_sv < abc_sv";
     local_counts.failed_checks++;
 
+#if defined(MICRO_TEST_PLUS_LITE)
+    // Owning strings, longer than the in place buffer; only the
+    // lite mode can report them.
+    expect (eq (std::string{ "abc, long enough to be allocated" },
+                std::string{ "abx, long enough to be allocated" }))
+        << "actual_s == abx_s";
+    local_counts.failed_checks++;
+
+    expect (ne (std::string{ compute_abc () }, "abc"sv))
+        << "actual_s != abc_sv";
+    local_counts.failed_checks++;
+#endif // defined(MICRO_TEST_PLUS_LITE)
+
+    local_counts.test_cases++;
+  });
+
+  test_assert (current_test_suite->successful_checks ()
+               == local_counts.successful_checks);
+  test_assert (current_test_suite->failed_checks ()
+               == local_counts.failed_checks);
+  test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+  test_case ("Erased string comparisons", [] {
+    // The erased strings must refer to the operands kept in the
+    // expression, not to the copies returned by the getters.
+    const auto expression = eq (std::string{ "abc, long enough to be kept" },
+                                std::string{ "abx, long enough to be kept" });
+    const auto lite = detail::make_lite_expression (expression);
+    const std::string other (28, '?');
+
+    capture_reporter capture;
+    capture << lite;
+    expect (capture.text ().find ("abc, long enough to be kept == "
+                                  "abx, long enough to be kept")
+            != std::string::npos)
+        << "erased std::string operands";
+    local_counts.successful_checks++;
+
+    capture_reporter null_capture;
+    null_capture << detail::make_lite_expression (eq (other.data (), nullptr));
+    expect (null_capture.text ().find (" == nullptr") != std::string::npos)
+        << "erased nullptr operand";
+    local_counts.successful_checks++;
+
     local_counts.test_cases++;
   });
 
@@ -1823,6 +2008,866 @@ static test_suite ts_misc = {
     test_assert (current_test_suite->failed_checks ()
                  == local_counts.failed_checks);
     test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    test_case ("Ranges", [] {
+      int a1[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+      std::array<int, 10> a2{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+      std::vector<int> v1{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+      expect (eq_range (a1, a2)) << "int[10] == array<int, 10>";
+      local_counts.successful_checks++;
+
+      expect (eq_range (a2, v1)) << "array<int, 10> == vector<int>";
+      local_counts.successful_checks++;
+
+      expect (eq_range (std::vector<int>{}, std::vector<int>{}))
+          << "vector{ } == vector{ }";
+      local_counts.successful_checks++;
+
+      std::vector<double> d1{ 1.5, 2.5 };
+      std::array<double, 2> d2{ 1.5, 2.5 };
+      expect (eq_range (d1, d2)) << "vector{ 1.5, 2.5 } == array{ 1.5, 2.5 }";
+      local_counts.successful_checks++;
+
+      // Validate the vectorised search for all offsets in and around
+      // the wide chunks.
+      std::array<std::uint8_t, 71> b1{};
+      std::array<std::uint8_t, 71> b2{};
+      std::size_t found = 0;
+      for (std::size_t i = 0; i < b1.size (); ++i)
+        {
+          b2[i] = 0xAA;
+          if (detail::first_mismatch (b1.data (), b2.data (), b1.size ())
+              == i)
+            {
+              found++;
+            }
+          b2[i] = 0;
+        }
+      expect (eq (found, b1.size ())) << "mismatch found at each offset";
+      local_counts.successful_checks++;
+
+      expect (eq (detail::mismatch_offset (b1.data (), b2.data (), b1.size ()),
+                  b1.size ()))
+          << "no mismatch in equal ranges";
+      local_counts.successful_checks++;
+
+      local_counts.test_cases++;
+    });
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    test_case ("Ranges failed", [] {
+      std::array<int, 10> a1{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+      std::array<int, 10> a2{ 1, 2, 3, 4, 5, 6, 7, 0, 9, 10 };
+
+      expect (eq_range (a1, a2)) << "different element";
+      local_counts.failed_checks++;
+
+      std::vector<int> v1{ 1, 2, 3 };
+      std::vector<int> v2{ 1, 2, 3, 4 };
+      expect (eq_range (v1, v2)) << "different sizes";
+      local_counts.failed_checks++;
+
+      std::vector<double> d1{ 1.5, 2.5 };
+      std::vector<double> d2{ 1.5, 2.75 };
+      expect (eq_range (d1, d2)) << "different doubles";
+      local_counts.failed_checks++;
+
+      local_counts.test_cases++;
+    });
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    test_case ("Byte buffers", [] {
+      static std::uint8_t b1[4099];
+      static std::uint8_t b2[4099];
+      for (std::size_t i = 0; i < sizeof (b1); ++i)
+        {
+          b1[i] = static_cast<std::uint8_t> (i);
+          b2[i] = static_cast<std::uint8_t> (i);
+        }
+
+      expect (eq_bytes (b1, b2, sizeof (b1))) << "b1 == b2";
+      local_counts.successful_checks++;
+
+      expect (eq_bytes (b1, b2, 0)) << "empty buffers";
+      local_counts.successful_checks++;
+
+      memset (b1, 0xAA, sizeof (b1));
+      expect (filled_with (b1, sizeof (b1), 0xAA)) << "b1 filled with 0xAA";
+      local_counts.successful_checks++;
+
+      // Validate the vectorised search for all offsets in and around
+      // the wide chunks.
+      std::size_t found = 0;
+      for (std::size_t i = 0; i < 71; ++i)
+        {
+          b1[i] = 0x55;
+          if (detail::fill_mismatch_offset (b1, 0xAA, 71) == i)
+            {
+              found++;
+            }
+          b1[i] = 0xAA;
+        }
+      expect (eq (found, 71u)) << "mismatch found at each offset";
+      local_counts.successful_checks++;
+
+      local_counts.test_cases++;
+    });
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    test_case ("Byte buffers failed", [] {
+      static std::uint8_t b1[1000];
+      static std::uint8_t b2[1000];
+      memset (b1, 0, sizeof (b1));
+      memset (b2, 0, sizeof (b2));
+
+      b2[0x25] = 0x11;
+      b2[0x27] = 0x22;
+      b2[0x3e7] = 0x33;
+      expect (eq_bytes (b1, b2, sizeof (b1))) << "three different bytes";
+      local_counts.failed_checks++;
+
+      for (std::size_t i = 0; i < sizeof (b2); i += 64)
+        {
+          b2[i] = 0xFF;
+        }
+      expect (eq_bytes (b1, b2, sizeof (b1))) << "many different rows";
+      local_counts.failed_checks++;
+
+      memset (b1, 0xAA, sizeof (b1));
+      b1[0x102] = 0xA8;
+      expect (filled_with (b1, sizeof (b1), 0xAA)) << "guard area overwritten";
+      local_counts.failed_checks++;
+
+      local_counts.test_cases++;
+    });
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    test_case ("Floating point arrays", [] {
+      std::vector<float> f1 (1001);
+      std::vector<float> f2 (1001);
+      for (std::size_t i = 0; i < f1.size (); ++i)
+        {
+          f1[i] = static_cast<float> (i) * 0.1f;
+          f2[i] = f1[i] * (1.0f + 1e-7f);
+        }
+
+      expect (all_close (f1, f2, 1e-6)) << "relative tolerance";
+      local_counts.successful_checks++;
+
+      expect (all_close (f1, f2, 0, 1e-4)) << "absolute tolerance";
+      local_counts.successful_checks++;
+
+      f2 = f1;
+      f2[500] = std::nextafter (f2[500], 1000.0f);
+      f2[501] = std::nextafter (std::nextafter (f2[501], 0.0f), 0.0f);
+      expect (all_close (f1, f2, 0, 0, 2)) << "ulps";
+      local_counts.successful_checks++;
+
+      std::array<double, 3> d1{ -1.0, 0.0, 1e300 };
+      std::array<double, 3> d2{ -1.0, -0.0, 1e300 };
+      expect (all_close (d1, d2, 0)) << "doubles";
+      local_counts.successful_checks++;
+
+      expect (all_close (std::vector<double>{}, std::vector<double>{}, 0))
+          << "empty";
+      local_counts.successful_checks++;
+
+      local_counts.test_cases++;
+    });
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    test_case ("Floating point arrays failed", [] {
+      std::vector<float> f1 (1001, 1.0f);
+      std::vector<float> f2 (1001, 1.0f);
+      f2[10] = 1.001f;
+      f2[700] = 1.1f;
+
+      expect (all_close (f1, f2, 1e-6, 0, 4)) << "two values not close";
+      local_counts.failed_checks++;
+
+      f2[20] = std::numeric_limits<float>::quiet_NaN ();
+      expect (all_close (f1, f2, 1, 1)) << "NaN is never close";
+      local_counts.failed_checks++;
+
+      std::vector<double> d1{ 1.0, 2.0 };
+      std::vector<double> d2{ 1.0, 2.0, 3.0 };
+      expect (all_close (d1, d2, 1e-9)) << "different sizes";
+      local_counts.failed_checks++;
+
+      local_counts.test_cases++;
+    });
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    test_case<type_traits::list<std::int8_t, std::uint16_t, int, float,
+                                double>> ("Typed test cases", []<class T> () {
+      T sum{};
+      for (T i = 1; i <= 4; ++i)
+        {
+          sum += i;
+        }
+      expect (eq (sum, T{ 10 }));
+      local_counts.successful_checks++;
+
+      local_counts.test_cases++;
+    });
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    test_case<type_traits::list<std::int32_t, std::int64_t>> (
+        "Typed test cases failed", []<class T> () {
+          expect (eq (sizeof (T), 4u)) << "4 bytes";
+          if constexpr (sizeof (T) == 4)
+            {
+              local_counts.successful_checks++;
+            }
+          else
+            {
+              local_counts.failed_checks++;
+            }
+
+          local_counts.test_cases++;
+        });
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    struct sum_row
+    {
+      int a;
+      int b;
+      int sum;
+    };
+
+    static constexpr sum_row sum_rows[] = {
+      { 1, 2, 3 }, { -1, 1, 0 }, { 0, 0, 0 }, { 100, -200, -100 },
+    };
+
+    table_case ("Tables", sum_rows,
+                [] (const sum_row& r) { return eq (r.a + r.b, r.sum); });
+    local_counts.successful_checks++;
+    local_counts.test_cases++;
+
+    static constexpr std::array<std::pair<const char*, std::size_t>, 3>
+        length_rows{ { { "", 0 }, { "abc", 3 }, { "µ", 2 } } };
+
+    table_case ("Tables with pairs", length_rows, [] (const auto& r) {
+      return std::strlen (r.first) == r.second;
+    });
+    local_counts.successful_checks++;
+    local_counts.test_cases++;
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    static constexpr sum_row wrong_sum_rows[] = {
+      { 1, 2, 3 }, { 2, 2, 5 }, { 3, 3, 6 }, { 4, 4, 9 },
+    };
+
+    table_case ("Tables failed", wrong_sum_rows,
+                [] (const sum_row& r) { return eq (r.a + r.b, r.sum); });
+    local_counts.failed_checks += 2;
+    local_counts.test_cases++;
+
+    table_case ("Tables failed with bools", length_rows, [] (const auto& r) {
+      return r.second < 3;
+    });
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    // Rows with fields the reporter cannot display directly.
+    enum class power
+    {
+      off,
+      on
+    };
+
+    struct power_row
+    {
+      power state;
+      int current;
+    };
+
+    static constexpr power_row power_rows[] = {
+      { power::off, 0 }, { power::on, 10 }, { power::on, 0 },
+    };
+
+    table_case ("Tables failed with enums", power_rows,
+                [] (const power_row& r) {
+                  return (r.state == power::on) == (r.current > 0);
+                });
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    struct range
+    {
+      int min;
+      int max;
+    };
+
+    struct range_row
+    {
+      range limits;
+      int value;
+    };
+
+    static constexpr range_row range_rows[] = {
+      { { 0, 10 }, 5 }, { { 0, 10 }, 11 },
+    };
+
+    table_case ("Tables failed with nested structures", range_rows,
+                [] (const range_row& r) {
+                  return r.value >= r.limits.min && r.value <= r.limits.max;
+                });
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    struct array_row
+    {
+      int values[3];
+      int sum;
+    };
+
+    static constexpr array_row array_rows[] = {
+      { { 1, 2, 3 }, 6 }, { { 1, 1, 1 }, 4 },
+    };
+
+    table_case ("Tables failed with arrays", array_rows,
+                [] (const array_row& r) {
+                  return eq (r.values[0] + r.values[1] + r.values[2], r.sum);
+                });
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    test_case ("Table rows", [] {
+      capture_reporter capture;
+      detail::print_row<power_row> (capture, &power_rows[1]);
+      detail::print_row<range_row> (capture, &range_rows[1]);
+      detail::print_row<array_row> (capture, &array_rows[1]);
+      expect (capture.text () == "{1, 10}{{...}, 11}{...}")
+          << "enum, nested and array rows";
+      local_counts.successful_checks++;
+
+      local_counts.test_cases++;
+    });
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    static constexpr int bauds[] = { 9600, 19200, 38400, 57600, 115200 };
+    static constexpr char parities[] = { 'N', 'E', 'O' };
+    static constexpr int stop_bits[] = { 1, 2 };
+    static constexpr bool flow_control[] = { false, true };
+    static constexpr std::array<const char*, 3> modes{ "rx", "tx", "duplex" };
+
+    static int combinations_count = 0;
+    combinations ("Combinations", bauds, parities, stop_bits, flow_control,
+                  modes,
+                  [] (int baud, char parity, int stop, bool,
+                      const char* mode) {
+                    expect (baud >= 9600 && parity != 0 && stop >= 1
+                            && mode != nullptr);
+                    combinations_count++;
+                    local_counts.successful_checks++;
+                    local_counts.test_cases++;
+                  });
+    // Much less than the full product (180).
+    test_assert (combinations_count >= 15 && combinations_count < 30);
+
+    combinations_count = 0;
+    combinations ("Combinations with options",
+                  combinations_options{ .strength = 3 }, parities, stop_bits,
+                  flow_control, [] (char, int, bool) {
+                    combinations_count++;
+                    local_counts.test_cases++;
+                  });
+    // All triples of 3 parameters is the full product.
+    test_assert (combinations_count == 12);
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    combinations ("Combinations failed", combinations_options{ .max_cases = 4 },
+                  bauds, parities, [] (int baud, char parity) {
+                    expect (baud != 9600 || parity != 'N') << "not 9600 N";
+                    if (baud == 9600 && parity == 'N')
+                      {
+                        local_counts.failed_checks++;
+                      }
+                    else
+                      {
+                        local_counts.successful_checks++;
+                      }
+                    local_counts.test_cases++;
+                  });
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    namespace gen = generators;
+
+    // Explicit seeds, to run the same values regardless of `--seed=`.
+    property ("Properties", property_options{ .seed = 1 },
+              gen::integer<int> (-1000, 1000),
+              gen::vector_of (gen::integer<std::uint8_t> ()),
+              gen::string (8), [] (int i, const std::vector<std::uint8_t>& v,
+                                   const std::string& str) {
+                std::vector<std::uint8_t> r{ v.rbegin (), v.rend () };
+                return (i * 2) / 2 == i && std::abs (i) <= 1000
+                       && std::vector<std::uint8_t>{ r.rbegin (), r.rend () }
+                              == v
+                       && str.size () <= 8;
+              });
+    local_counts.successful_checks++;
+    local_counts.test_cases++;
+
+    property ("Properties with options",
+              property_options{ .iterations = 20, .seed = 42 },
+              gen::floating<double> (-1.0, 1.0), gen::boolean (),
+              gen::element_of ({ 'a', 'b', 'c' }),
+              [] (double d, bool, char c) {
+                return d >= -1.0 && d <= 1.0 && c >= 'a' && c <= 'c';
+              });
+    local_counts.successful_checks++;
+    local_counts.test_cases++;
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    property ("Properties failed", property_options{ .seed = 2 },
+              gen::integer<int> (), [] (int i) { return i < 100; });
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    property ("Properties failed with vectors", property_options{ .seed = 3 },
+              gen::vector_of (gen::integer<int> (0, 1000)),
+              [] (const std::vector<int>& v) {
+                return v.size () < 3 || v[2] < 500;
+              });
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    property ("Properties failed with strings", property_options{ .seed = 4 },
+              gen::string (),
+              [] (const std::string& str) {
+                return str.find ('b') == std::string::npos;
+              });
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    test_case ("Linearizability", [] {
+      using operation = register_operation;
+
+      // A read overlapping a write may return either value.
+      history<operation, int> overlapping{ 4 };
+      std::size_t write = overlapping.invoke (0, { true, 1 });
+      std::size_t read = overlapping.invoke (1, { false, 0 });
+      overlapping.response (write, 0);
+      overlapping.response (read, 1);
+      expect (linearizable (overlapping, register_model{}))
+          << "overlapping read and write";
+
+      // A write that did not return may have taken effect.
+      history<operation, int> pending{ 4 };
+      pending.invoke (0, { true, 2 });
+      pending.record (1, { false, 0 }, [] { return 2; });
+      pending.record (1, { false, 0 }, [] { return 2; });
+      expect (linearizable (pending, register_model{}))
+          << "pending write";
+
+      // A read after a write returned must see it.
+      history<operation, int> stale{ 4 };
+      stale.record (0, { true, 1 }, [] { return 0; });
+      stale.record (1, { false, 0 }, [] { return 0; });
+      auto result = linearizable (stale, register_model{});
+      expect (not static_cast<bool> (result)) << "stale read found";
+      expect (eq (result.longest_, 1u)) << "only the write ordered";
+      expect (eq (result.thread_, 1u)) << "the read of thread 1";
+
+      history<operation, int> full{ 1 };
+      full.record (0, { true, 1 }, [] { return 0; });
+      full.record (0, { false, 0 }, [] { return 1; });
+      expect (eq (full.dropped (), 1u)) << "one operation dropped";
+      expect (not static_cast<bool> (linearizable (full, register_model{})))
+          << "full history fails";
+
+      full.clear ();
+      expect (linearizable (full, register_model{})) << "empty history";
+    });
+    local_counts.successful_checks += 8;
+    local_counts.test_cases++;
+
+    test_case ("Mocks", [] {
+      bus_mock bus;
+      bus.write_.will_return (2);
+      expect (eq (send_to_bus (bus, 0x50), 2)) << "returned value";
+
+      expect (mock::called (bus.write_, 1)) << "write called once";
+      expect (mock::called (bus.select_, 2)) << "select called twice";
+      expect (mock::called (bus.write_, 1, 0x50, mock::_))
+          << "write matched with a value";
+      expect (mock::called (
+          bus.write_, 0, [] (std::uint8_t address) { return address > 0x60; },
+          mock::_))
+          << "write matched with a predicate";
+      expect (mock::in_order (mock::call (bus.select_, true),
+                              mock::call (bus.write_, 0x50, 2u),
+                              mock::call (bus.select_, false)))
+          << "calls in order";
+      expect (not static_cast<bool> (mock::in_order (
+          mock::call (bus.select_, false), mock::call (bus.write_))))
+          << "calls not in order";
+
+      bus.write_.will_invoke ([] (std::uint8_t, std::size_t size) {
+        return static_cast<int> (size) * 10;
+      });
+      expect (eq (send_to_bus (bus, 0x51), 20)) << "invoked function";
+
+      for (int i = 0; i < 5; ++i)
+        {
+          send_to_bus (bus, 0x52);
+        }
+      expect (mock::called (bus.select_, 14)) << "all calls counted";
+      expect (gt (bus.log.dropped (), 0u)) << "some calls not recorded";
+      expect (not static_cast<bool> (mock::called (bus.write_, 7, mock::_, 2u)))
+          << "calls not recorded are not matched";
+
+      bus.log.clear ();
+      expect (mock::called (bus.write_, 0)) << "cleared";
+      expect (eq (bus.log.used (), 0u)) << "arena reused";
+    });
+    local_counts.successful_checks += 13;
+    local_counts.test_cases++;
+
+    test_case ("Mocks failed", [] {
+      bus_mock bus;
+      send_to_bus (bus, 0x50);
+      expect (mock::called (bus.write_, 2, 0x50, mock::_));
+      expect (mock::in_order (mock::call (bus.write_),
+                              mock::call (bus.select_, true)));
+    });
+    local_counts.failed_checks += 2;
+    local_counts.test_cases++;
+
+    test_case ("Linearizability failed", [] {
+      history<register_operation, int> stale{ 4 };
+      stale.record (0, { true, 1 }, [] { return 0; });
+      stale.record (1, { false, 0 }, [] { return 0; });
+      expect (linearizable (stale, register_model{}));
+    });
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+#if defined(MICRO_TEST_PLUS_THREAD_SAFE)
+    test_case ("Checks from threads", [] {
+      std::vector<std::thread> threads;
+      for (int t = 0; t < 4; ++t)
+        {
+          threads.emplace_back ([] {
+            for (int i = 0; i < 25; ++i)
+              {
+                expect (eq (i * 2, i + i)) << "checked in a thread";
+              }
+          });
+        }
+      for (auto& thread : threads)
+        {
+          thread.join ();
+        }
+      expect (true) << "checked in the runner thread";
+    });
+    local_counts.successful_checks += 4 * 25 + 1;
+    local_counts.test_cases++;
+
+    test_case ("Checks from threads failed", [] {
+      std::thread thread{ [] {
+        expect (eq (my_actual_integral (), 43)) << "failed in a thread";
+        expect (eq (my_actual_integral (), 42)) << "passed in a thread";
+      } };
+      thread.join ();
+    });
+    local_counts.successful_checks++;
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    test_case ("Checks from threads with many messages", [] {
+      // More messages than the thread buffer can keep; in verbose
+      // mode some are dropped, but all checks are counted.
+      std::thread thread{ [] {
+        for (int i = 0; i < 300; ++i)
+          {
+            expect (eq (i, i)) << "checked in a thread";
+          }
+      } };
+      thread.join ();
+    });
+    local_counts.successful_checks += 300;
+    local_counts.test_cases++;
+
+    test_case ("Checks from threads failed after many messages", [] {
+      // The thread buffer is full, but the failures are displayed.
+      std::thread thread{ [] {
+        for (int i = 0; i < 300; ++i)
+          {
+            expect (eq (i, i)) << "checked in a thread";
+          }
+        for (int i = 0; i < 2; ++i)
+          {
+            expect (eq (i, -1)) << "failed in a thread after many";
+          }
+      } };
+      thread.join ();
+    });
+    local_counts.successful_checks += 300;
+    local_counts.failed_checks += 2;
+    local_counts.test_cases++;
+
+    test_case ("Stress", [] {
+      std::atomic<int> counter{ 0 };
+      expect (stress (4, 1000, [&] (std::size_t, std::size_t) {
+        counter.fetch_add (1, std::memory_order_relaxed);
+      }));
+      expect (eq (counter.load (), 4000)) << "all iterations executed";
+
+      expect (stress (2, 100, [] { return true; })) << "stress with bool";
+    });
+    local_counts.successful_checks += 3;
+    local_counts.test_cases++;
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+
+    test_case ("Stress failed", [] {
+      expect (stress (3, 100, [] (std::size_t thread, std::size_t iteration) {
+        return thread != 1 || iteration % 10 != 0;
+      }));
+    });
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    test_case ("Stress failed with checks", [] {
+      expect (stress (2, 10, [] (std::size_t thread, std::size_t iteration) {
+        expect (thread == 0 || iteration != 5) << "checked in a thread";
+      }));
+    });
+    // 19 checks in the threads passed, one failed, as the stress.
+    local_counts.successful_checks += 19;
+    local_counts.failed_checks += 2;
+    local_counts.test_cases++;
+
+    test_case ("Explore", [] {
+      interleavings::atomic<int> counter;
+      const auto reset = [&] { counter.store (0); };
+      const auto is_two = [&] { return counter.load () == 2; };
+
+      auto result = explore (
+          2, reset, [&] { counter.fetch_add (1); }, is_two);
+      expect (result) << "atomic increment";
+      expect (result.exhausted_) << "all schedules explored";
+
+      interleavings::mutex mutex;
+      expect (explore (
+          3, reset,
+          [&] {
+            std::lock_guard<interleavings::mutex> lock{ mutex };
+            counter.store (counter.load () + 1);
+          },
+          [&] { return counter.load () == 3; }))
+          << "increment under mutex";
+
+      expect (explore (
+          2, reset, [&] { counter.store (counter.load () + 1); }, is_two,
+          { .random = true, .seed = 42, .schedule = "0.0.0" }))
+          << "replayed schedule without preemptions";
+
+      // The updates of one thread are lost if the other one
+      // is preempted between load() and store().
+      const auto lost_update = [&] (std::size_t) {
+        counter.store (counter.load () + 1);
+      };
+      auto failed = explore (2, reset, lost_update, is_two);
+      expect (not static_cast<bool> (failed)) << "lost update found";
+      expect (failed.failure_ == detail::explore_::failure::check);
+      expect (eq (failed.preemptions_, 1u)) << "with one preemption";
+
+      auto replayed
+          = explore (2, reset, lost_update, is_two,
+                     { .schedule = failed.schedule_.c_str () });
+      expect (not static_cast<bool> (replayed)) << "replayed";
+      expect (eq (replayed.schedules_, 1u)) << "only the given schedule";
+      expect (replayed.schedule_ == failed.schedule_) << "same schedule";
+
+      auto random = explore (2, reset, lost_update, is_two,
+                             { .max_schedules = 1000, .random = true });
+      expect (not static_cast<bool> (random)) << "lost update found randomly";
+
+      interleavings::mutex a;
+      interleavings::mutex b;
+      auto deadlock = explore (
+          2, [] {},
+          [&] (std::size_t thread) {
+            std::lock_guard<interleavings::mutex> first{ thread == 0 ? a
+                                                                     : b };
+            std::lock_guard<interleavings::mutex> second{ thread == 0 ? b
+                                                                      : a };
+          },
+          [] {});
+      expect (deadlock.failure_ == detail::explore_::failure::deadlock)
+          << "deadlock found";
+    });
+    local_counts.successful_checks += 12;
+    local_counts.test_cases++;
+
+    test_case ("Linearizability with threads", [] {
+      std::mutex mutex;
+      register_model shared;
+      history<register_operation, int> recorded{ 4 * 100 };
+      expect (stress (4, 100, [&] (std::size_t thread, std::size_t i) {
+        const register_operation operation{ i % 2 == 0,
+                                             static_cast<int> (i) };
+        recorded.record (thread, operation, [&] {
+          std::lock_guard<std::mutex> lock{ mutex };
+          return shared.apply (operation);
+        });
+      }));
+      expect (linearizable (recorded, register_model{}))
+          << "register under mutex";
+    });
+    local_counts.successful_checks += 2;
+    local_counts.test_cases++;
+
+    test_case ("Explore failed", [] {
+      interleavings::atomic<int> counter;
+      expect (explore (
+          2, [&] { counter.store (0); },
+          [&] { counter.store (counter.load () + 1); },
+          [&] { return counter.load () == 2; }));
+    });
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
+#endif // defined(MICRO_TEST_PLUS_THREAD_SAFE)
+  }
+};
+
+// ----------------------------------------------------------------------------
+
+// Test cases registered as static objects, executed by the runner
+// after the test suite function.
+static test_suite ts_registered = {
+  "Registered test cases",
+  [] {
+    local_counts = {};
+    test_assert (current_test_suite->test_cases () == 0);
+  }
+};
+
+static registered_test_case tc_registered{
+  ts_registered, "Registered test cases",
+  [] {
+    expect (eq (my_actual_integral (), 42)) << "registered eq";
+    local_counts.successful_checks++;
+    local_counts.test_cases++;
+  },
+  "fast, integrals"
+};
+
+static registered_test_case tc_registered_failed{
+  ts_registered, "Registered test cases failed",
+  [] {
+    expect (eq (my_actual_integral (), 43)) << "registered eq failed";
+    local_counts.failed_checks++;
+    local_counts.test_cases++;
+  },
+  "integrals"
+};
+
+static registered_test_case tc_registered_counts{
+  ts_registered, "Registered test cases counts", [] {
+    local_counts.test_cases++;
+
+    test_assert (tc_registered.has_tag ("fast"));
+    test_assert (tc_registered.has_tag ("integrals"));
+    test_assert (not tc_registered.has_tag ("fas"));
+    test_assert (not tc_registered_failed.has_tag ("fast"));
+
+    test_assert (current_test_suite->successful_checks ()
+                 == local_counts.successful_checks);
+    test_assert (current_test_suite->failed_checks ()
+                 == local_counts.failed_checks);
+    test_assert (current_test_suite->test_cases () == local_counts.test_cases);
   }
 };
 